@@ -5,9 +5,14 @@ import logging
 from homeassistant.config_entries import ConfigEntry
 from homeassistant.const import Platform
 from homeassistant.core import HomeAssistant
+import homeassistant.helpers.config_validation as cv
+from homeassistant.util import dt as dt_util
 
 from .const import (
     DOMAIN,
+    DATA_HUB,
+    DATA_IO_SCHEDULER,
+    DATA_GROUPS,
     PLATFORMS,
     CONF_HOST,
     CONF_PORT,
@@ -18,16 +23,44 @@ from .const import (
     CONF_REGISTER_BLOCK_SIZE,
     CONF_CONNECTION_RETRIES,
     CONF_BATTERY_ENTITIES,
+    CONF_BURST_DURATION,
+    CONF_WRITE_DEBOUNCE,
+    CONF_EXPORT_LIMIT,
+    CONF_PARALLEL_GROUP,
+    CONF_RATED_POWER,
     DEFAULT_READ_ONLY,
     DEFAULT_REGISTER_BLOCK_SIZE,
     DEFAULT_CONNECTION_RETRIES,
     DEFAULT_BATTERY_ENTITIES,
+    DEFAULT_BURST_DURATION,
+    DEFAULT_WRITE_DEBOUNCE,
+    DEFAULT_EXPORT_LIMIT,
+    DEFAULT_PARALLEL_GROUP,
+    DEFAULT_RATED_POWER,
+    LIVE_RECONFIGURABLE_OPTIONS,
+    POLL_BUDGET_FRACTION,
 )
+from .classes.dongle_hub import DongleHub
+from .classes.io_scheduler import IoScheduler
 from .classes.modbus_client import LxpModbusApiClient
+from .classes.register_snapshot import RegisterSnapshotStore
 from .coordinator import LxpModbusDataUpdateCoordinator
+from .entity_descriptions.sensor_types import GROUP_INPUT_REGISTERS
+from .export_control import ExportLimitController
+from .force_charge import REASON_UNLOADED, ForceChargeSession, force_charge_store
+from .group import ParallelGroup
+from .services import async_setup_services
 
 _LOGGER = logging.getLogger(__name__)
 
+CONFIG_SCHEMA = cv.config_entry_only_config_schema(DOMAIN)
+
+async def async_setup(hass: HomeAssistant, config: dict) -> bool:
+    """Register the integration's services once for all config entries."""
+    hass.data.setdefault(DOMAIN, {})
+    async_setup_services(hass)
+    return True
+
 async def async_setup_entry(hass: HomeAssistant, entry: ConfigEntry) -> bool:
     """Set up the LuxPower Modbus component from a config entry."""
     # Ensure the top-level dictionary for our integration exists in hass.data
@@ -44,50 +77,93 @@ async def async_setup_entry(hass: HomeAssistant, entry: ConfigEntry) -> bool:
     battery_entities = entry.data.get(CONF_BATTERY_ENTITIES, DEFAULT_BATTERY_ENTITIES).replace(" ", "").split(",")
     request_battery_data = bool(battery_entities) and 'none' not in battery_entities
 
-    # Create a single asyncio.Lock to prevent read/write race conditions
-    lock = asyncio.Lock()
+    # Entries on the same dongle share its session: one lock prevents read/write races and
+    # competing connections, one circuit breaker backs off for all of them
     block_size = entry.data.get(CONF_REGISTER_BLOCK_SIZE, DEFAULT_REGISTER_BLOCK_SIZE)
     connection_retries = entry.data.get(CONF_CONNECTION_RETRIES, DEFAULT_CONNECTION_RETRIES)
+    hub = hass.data[DOMAIN].setdefault(DATA_HUB, DongleHub())
+    session = hub.acquire(host, port)
+    io_scheduler = hass.data[DOMAIN].setdefault(DATA_IO_SCHEDULER, IoScheduler())
+    lock = session.lock
     api_client = LxpModbusApiClient(
         host, port, dongle_serial, inverter_serial, lock, block_size, connection_retries,
-        request_battery_data=request_battery_data
+        request_battery_data=request_battery_data,
+        poll_budget=poll_interval * POLL_BUDGET_FRACTION,
+        write_debounce=entry.data.get(CONF_WRITE_DEBOUNCE, DEFAULT_WRITE_DEBOUNCE) / 1000,
+        circuit_breaker=session.circuit_breaker,
+        io_scheduler=io_scheduler,
     )
+    session.register(entry.entry_id, inverter_serial, api_client.accept_routed_frame, connection_retries)
+    api_client.on_foreign_frame = session.route
+    entry.async_on_unload(lambda: hub.release(session, entry.entry_id))
 
     # Create our custom coordinator
     coordinator = LxpModbusDataUpdateCoordinator(
         hass,
         api_client,
         poll_interval,
-        entry.title
+        entry.title,
+        burst_duration=entry.data.get(CONF_BURST_DURATION, DEFAULT_BURST_DURATION),
     )
 
+    snapshot_store = RegisterSnapshotStore(hass, entry.entry_id)
+
     # Store the coordinator and other shared objects in hass.data for this entry
     hass.data[DOMAIN][entry.entry_id] = {
         "coordinator": coordinator,
         "settings": {**entry.data, **entry.options},
         "lock": lock,
-        "api_client": api_client
+        "api_client": api_client,
+        "dongle_session": session,
+        "snapshot_store": snapshot_store,
     }
 
-    # Perform the first data refresh. This will block setup until the first poll is
-    # successful. It also handles exceptions and configuration entry setup retries.
-    try:
-        await coordinator.async_config_entry_first_refresh()
-    except Exception as e:
-        # If first refresh fails, log the error but continue setup
-        # This allows the integration to be configured even if the inverter
-        # is temporarily unavailable
-        _LOGGER.error("Initial data refresh failed: %s. Setup will continue, but entities may be unavailable until connection is established.", e)
-
-        # Schedule a refresh soon to try again
-        async def delayed_refresh(now=None):
-            try:
-                await coordinator.async_refresh()
-            except Exception as refresh_err:
-                _LOGGER.error("Delayed refresh attempt failed: %s", refresh_err)
-
-        # Try again in 30 seconds
-        hass.loop.call_later(30, lambda: hass.async_create_task(delayed_refresh()))
+    # Persist the last good data after live polls (throttled by the store)
+    def _schedule_snapshot_save():
+        if coordinator.data and not api_client.data_is_stale:
+            snapshot_store.async_schedule_save(coordinator.data)
+
+    entry.async_on_unload(coordinator.async_add_listener(_schedule_snapshot_save))
+
+    # Members of a parallel group poll in aligned cycles
+    group_name = entry.data.get(CONF_PARALLEL_GROUP, DEFAULT_PARALLEL_GROUP).strip()
+    if group_name:
+        groups = hass.data[DOMAIN].setdefault(DATA_GROUPS, {})
+        group = groups.setdefault(group_name, ParallelGroup(group_name, GROUP_INPUT_REGISTERS))
+        group.add_member(entry.entry_id, coordinator)
+        coordinator.join_group(group, entry.entry_id)
+        hass.data[DOMAIN][entry.entry_id]["group"] = group
+
+        def _leave_group():
+            group.remove_member(entry.entry_id)
+            if not group.members:
+                groups.pop(group_name, None)
+
+        entry.async_on_unload(_leave_group)
+    entry.async_on_unload(entry.add_update_listener(async_update_options))
+
+    # Setup never waits for a full poll: entities start from the persisted snapshot
+    # (marked stale) or, without one, from a short identity read, and the first full
+    # poll runs in the background, populating entities block by block. If it fails,
+    # the coordinator schedule (paced by the circuit breaker) retries it.
+    snapshot = await snapshot_store.async_load()
+    if snapshot:
+        _LOGGER.info("Restored register snapshot for %s, first live poll runs in the background", entry.title)
+        coordinator.async_set_updated_data(api_client.restore_snapshot(snapshot))
+    else:
+        await api_client.async_read_identity()
+        coordinator.async_set_updated_data(api_client.cached_data)
+
+    # Entries set up together start polling a few seconds apart instead of in step
+    first_poll_delay = io_scheduler.register(entry.entry_id)
+    entry.async_on_unload(lambda: io_scheduler.unregister(entry.entry_id))
+
+    async def _async_first_poll():
+        if first_poll_delay:
+            await asyncio.sleep(first_poll_delay)
+        await coordinator.async_refresh()
+
+    entry.async_create_background_task(hass, _async_first_poll(), f"{DOMAIN} first poll {entry.title}")
 
     # Determine which platforms to load based on the read-only setting
     settings = hass.data[DOMAIN][entry.entry_id]["settings"]
@@ -108,11 +184,73 @@ async def async_setup_entry(hass: HomeAssistant, entry: ConfigEntry) -> bool:
     # Forward the setup to all platforms (sensor, number, etc.)
     await hass.config_entries.async_forward_entry_setups(entry, platforms_to_load)
 
+    # The export limit controller writes the feed-in limit, so it needs a writable entry
+    export_limit = settings.get(CONF_EXPORT_LIMIT, DEFAULT_EXPORT_LIMIT)
+    if export_limit >= 0 and not is_read_only:
+        controller = ExportLimitController(
+            coordinator, api_client, export_limit, settings.get(CONF_RATED_POWER, DEFAULT_RATED_POWER))
+        controller.start()
+        entry.async_on_unload(controller.stop)
+        hass.data[DOMAIN][entry.entry_id]["export_control"] = controller
+
+    # A force charge interrupted by a restart resumes, or restores the settings if it is overdue
+    force_charge = await ForceChargeSession.async_load(hass, entry.entry_id, coordinator, api_client)
+    if force_charge is not None:
+        hass.data[DOMAIN][entry.entry_id]["force_charge"] = force_charge
+        entry.async_create_background_task(
+            hass, force_charge.async_resume(dt_util.now()), f"{DOMAIN} resume force charge {entry.title}")
+
     return True
 
+async def async_update_options(hass: HomeAssistant, entry: ConfigEntry) -> None:
+    """Apply changed options in place; reload only when more than polling parameters changed."""
+    entry_data = hass.data[DOMAIN].get(entry.entry_id)
+    if entry_data is None:
+        return
+
+    old_settings = entry_data["settings"]
+    new_settings = {**entry.data, **entry.options}
+    changed = {key for key in old_settings.keys() | new_settings.keys() if old_settings.get(key) != new_settings.get(key)}
+    if not changed:
+        return
+
+    if not changed.issubset(LIVE_RECONFIGURABLE_OPTIONS):
+        _LOGGER.info("Options %s changed, reloading %s", ", ".join(sorted(changed)), entry.title)
+        await hass.config_entries.async_reload(entry.entry_id)
+        return
+
+    _LOGGER.info("Applying %s to %s without reload", ", ".join(sorted(changed)), entry.title)
+    poll_interval = new_settings[CONF_POLL_INTERVAL]
+    connection_retries = new_settings.get(CONF_CONNECTION_RETRIES, DEFAULT_CONNECTION_RETRIES)
+    entry_data["api_client"].reconfigure(
+        block_size=new_settings.get(CONF_REGISTER_BLOCK_SIZE, DEFAULT_REGISTER_BLOCK_SIZE),
+        connection_retries=connection_retries,
+        poll_budget=poll_interval * POLL_BUDGET_FRACTION,
+        write_debounce=new_settings.get(CONF_WRITE_DEBOUNCE, DEFAULT_WRITE_DEBOUNCE) / 1000,
+    )
+    # The shared circuit breaker follows the largest setting of the dongle's inverters
+    entry_data["dongle_session"].set_connection_retries(entry.entry_id, connection_retries)
+    coordinator = entry_data["coordinator"]
+    coordinator.reconfigure(
+        poll_interval=poll_interval,
+        burst_duration=new_settings.get(CONF_BURST_DURATION, DEFAULT_BURST_DURATION),
+    )
+    entry_data["settings"] = new_settings
+
+    # Poll right away so the new interval and block size take effect immediately
+    await coordinator.async_request_refresh()
+
 async def async_unload_entry(hass: HomeAssistant, entry: ConfigEntry) -> bool:
     """Unload a config entry."""
 
+    # A running force charge restores the inverter settings before the client goes away
+    force_charge = hass.data[DOMAIN][entry.entry_id].get("force_charge")
+    if force_charge is not None and force_charge.active:
+        await force_charge.async_stop(REASON_UNLOADED)
+
+    # Let submitted entity writes finish so the saved snapshot holds no unconfirmed values
+    await hass.data[DOMAIN][entry.entry_id]["api_client"].async_wait_for_writes()
+
     # Get the list of platforms that were actually loaded
     loaded_platforms = hass.data[DOMAIN][entry.entry_id].get("platforms", PLATFORMS)
 
@@ -120,6 +258,16 @@ async def async_unload_entry(hass: HomeAssistant, entry: ConfigEntry) -> bool:
     unload_ok = await hass.config_entries.async_unload_platforms(entry, loaded_platforms)
 
     if unload_ok:
-        hass.data[DOMAIN].pop(entry.entry_id)
+        entry_data = hass.data[DOMAIN].pop(entry.entry_id)
+
+        # Persist the latest live data so the next setup starts from it
+        coordinator = entry_data["coordinator"]
+        if coordinator.data and not entry_data["api_client"].data_is_stale:
+            await entry_data["snapshot_store"].async_save(coordinator.data)
 
     return unload_ok
+
+async def async_remove_entry(hass: HomeAssistant, entry: ConfigEntry) -> None:
+    """Delete the persisted register snapshot and force charge state when a config entry is removed."""
+    await RegisterSnapshotStore(hass, entry.entry_id).async_remove()
+    await force_charge_store(hass, entry.entry_id).async_remove()
@@ -44,8 +44,8 @@ class ModbusBridgeButton(ModbusBridgeEntity, ButtonEntity):
         # Use the press function from the description to determine the new value to write
         new_register_value = self._press(original_register_value)
 
-        # Call the write method on the API client
-        success = await self._api_client.async_write_register(self._register, new_register_value)
+        # A press is an action: write even if the register already holds this value
+        success = await self._api_client.async_write_register(self._register, new_register_value, force=True)
         
         if success:
             # After a successful write, request an immediate refresh from the coordinator.
@@ -0,0 +1,102 @@
+"""Polling schedule and per-pack freshness of the battery register range."""
+import logging
+import time as time_lib
+
+from ..const import BATTERY_EMPTY_PAGE_READS, BATTERY_POLL_INTERVAL, BATTERY_STALE_AFTER
+from .poll_plan import RegisterBlock
+
+_LOGGER = logging.getLogger(__name__)
+
+
+class BatterySchedule:
+    """Decides which battery pages a poll cycle reads and tracks when each pack was last seen.
+
+    Battery data changes slowly, so every page is read at most once per
+    interval instead of on every poll. A page that timed out stays due and is
+    retried in the next cycle. Each pack carries its own last-seen time and
+    only counts as stale once it has not been decoded for stale_after seconds,
+    independently of the other packs and of input/hold polling.
+
+    A failed read and a page whose pack slots hold no serial look alike (no
+    pack decoded), so a page stays due until it has come back without a pack
+    BATTERY_EMPTY_PAGE_READS times in a row; it then counts as read and empty.
+    """
+
+    def __init__(self, interval: float = BATTERY_POLL_INTERVAL, stale_after: float = BATTERY_STALE_AFTER,
+                 clock=time_lib.monotonic):
+        """Initialize an empty schedule; every page is due on the first cycle."""
+        self._interval = interval
+        self._stale_after = stale_after
+        self._clock = clock
+        self._page_read = {}  # page start register -> time of the last successful read
+        self._page_serials = {}  # page start register -> serials decoded from its last read
+        self._last_seen = {}  # battery serial -> time its block was last decoded
+        self._empty_reads = {}  # page start register -> consecutive reads without any pack
+        self._timeouts = 0
+
+    def due_pages(self, pages: list[RegisterBlock]) -> list[RegisterBlock]:
+        """Return the pages whose last successful read is older than the interval."""
+        now = self._clock()
+        return [page for page in pages
+                if now - self._page_read.get(page.start, float("-inf")) >= self._interval]
+
+    def record_page(self, page: RegisterBlock, batteries: dict) -> None:
+        """Record the packs decoded from a page; a page without any pack stays due until it is taken as empty."""
+        if batteries:
+            self._empty_reads.pop(page.start, None)
+        else:
+            self._empty_reads[page.start] = self._empty_reads.get(page.start, 0) + 1
+            if self._empty_reads[page.start] < BATTERY_EMPTY_PAGE_READS:
+                return
+            _LOGGER.debug("Battery page at %s holds no pack", page.start)
+        now = self._clock()
+        self._page_read[page.start] = now
+        self._page_serials[page.start] = set(batteries)
+        for serial in batteries:
+            self._last_seen[serial] = now
+
+    def prune(self, pages: list[RegisterBlock]) -> None:
+        """Forget pages that are no longer polled, e.g. after the pack count dropped."""
+        current = {page.start for page in pages}
+        for start in [start for start in self._page_serials if start not in current]:
+            del self._page_serials[start]
+            self._page_read.pop(start, None)
+        for start in [start for start in self._empty_reads if start not in current]:
+            del self._empty_reads[start]
+
+    def covers(self, pages: list[RegisterBlock]) -> bool:
+        """Return True once every page has been read, so the located serials are the whole bank."""
+        return all(page.start in self._page_serials for page in pages)
+
+    @property
+    def located(self) -> set:
+        """Serials found by the last read of each page."""
+        return set().union(*self._page_serials.values())
+
+    def forget(self, serial: str) -> None:
+        self._last_seen.pop(serial, None)
+
+    def record_timeout(self, page: RegisterBlock) -> None:
+        self._timeouts += 1
+        _LOGGER.debug("Battery page at %s timed out, retrying next cycle", page.start)
+
+    def restore(self, serials) -> None:
+        """Treat packs restored from a snapshot as seen now, so they expire like polled ones."""
+        now = self._clock()
+        for serial in serials:
+            self._last_seen.setdefault(serial, now)
+
+    def is_fresh(self, serial: str) -> bool:
+        """Return True if the pack was decoded within the staleness window."""
+        seen = self._last_seen.get(serial)
+        return seen is not None and self._clock() - seen < self._stale_after
+
+    def get_stats(self) -> dict:
+        """Return schedule statistics for diagnostics."""
+        now = self._clock()
+        return {
+            "packs": len(self._last_seen),
+            "stale": sorted(serial for serial in self._last_seen if not self.is_fresh(serial)),
+            "oldest_age": round(max((now - seen for seen in self._last_seen.values()), default=0), 1),
+            "timeouts": self._timeouts,
+        }
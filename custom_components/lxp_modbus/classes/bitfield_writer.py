@@ -0,0 +1,106 @@
+"""Batched read-modify-write of bitfields that share a hold register."""
+import asyncio
+import logging
+
+from ..const import RMW_BATCH_WINDOW
+
+_LOGGER = logging.getLogger(__name__)
+
+REGISTER_MASK = 0xFFFF
+
+
+def compose_to_mask(compose, value: int) -> tuple[int, int]:
+    """Derive (mask, bits) from an entity's compose(orig, value) function.
+
+    Bits that compose passes through from the original register value are
+    outside the mask; every other bit is set by the write to compose(0, value).
+    """
+    bits = compose(0, value) & REGISTER_MASK
+    passed_through = compose(REGISTER_MASK, value) & ~bits & REGISTER_MASK
+    return REGISTER_MASK & ~passed_through, bits
+
+
+class _BitBatch:
+    """Bit changes collected for one register during the batch window."""
+
+    def __init__(self, future: asyncio.Future):
+        self.future = future
+        self.mask = 0
+        self.bits = 0
+
+    def add(self, mask: int, bits: int) -> None:
+        # A later change of the same bit wins
+        self.bits = (self.bits & ~mask) | (bits & mask)
+        self.mask |= mask
+
+
+class BitfieldWriteBatcher:
+    """Merges concurrent bit changes per register into one masked write.
+
+    The first caller for a register waits window seconds, collecting changes
+    from any other caller for the same register, then performs a single
+    write_func(register, mask, bits). While an earlier write of the register
+    is still running the batch stays open, so at most one write per register
+    is in flight and one is pending; a rapid series of whole-register values
+    therefore ends in a single write of the latest one. Every caller of the
+    batch receives its result: the confirmed register value, or None if the
+    write failed.
+    """
+
+    def __init__(self, write_func, window: float = RMW_BATCH_WINDOW):
+        """Initialize the batcher with the coroutine performing a masked write."""
+        self._write_func = write_func
+        self._window = window
+        self._pending = {}
+        self._register_locks = {}
+        self._batched_changes = 0
+        self._writes = 0
+
+    async def async_write_bits(self, register: int, mask: int, bits: int, window: float | None = None) -> int | None:
+        """Queue a change of the masked bits and return the confirmed register value.
+
+        window overrides the default batch window when this call opens a new batch.
+        """
+        mask &= REGISTER_MASK
+        batch = self._pending.get(register)
+        if batch is not None:
+            batch.add(mask, bits)
+            self._batched_changes += 1
+            _LOGGER.debug("Batched change 0x%04x for register %s", mask, register)
+            return await asyncio.shield(batch.future)
+
+        batch = _BitBatch(asyncio.get_running_loop().create_future())
+        batch.add(mask, bits)
+        self._pending[register] = batch
+        register_lock = self._register_locks.setdefault(register, asyncio.Lock())
+        try:
+            await asyncio.sleep(self._window if window is None else window)
+            async with register_lock:
+                # Changes arriving from now on start a new batch
+                del self._pending[register]
+                self._writes += 1
+                result = await self._write_func(register, batch.mask, batch.bits)
+        except asyncio.CancelledError:
+            if self._pending.get(register) is batch:
+                del self._pending[register]
+            batch.future.cancel()
+            raise
+        except Exception as err:
+            batch.future.set_exception(err)
+            # Mark the exception as retrieved in case no other caller joined
+            batch.future.exception()
+            raise
+        batch.future.set_result(result)
+        return result
+
+    def is_busy(self, register: int) -> bool:
+        """Return True while a change of the register is pending or being written."""
+        lock = self._register_locks.get(register)
+        return register in self._pending or (lock is not None and lock.locked())
+
+    def get_stats(self) -> dict:
+        """Return batching statistics for diagnostics."""
+        return {
+            "masked_writes": self._writes,
+            "batched_changes": self._batched_changes,
+        }
@@ -0,0 +1,69 @@
+"""Detection of inverter state transitions that warrant burst polling."""
+import logging
+
+from ..constants.input_registers import (
+    I_FAULT_CODE_H,
+    I_FAULT_CODE_L,
+    I_INTERNAL_FAULT,
+    I_STATE,
+    I_WARNING_CODE_H,
+    I_WARNING_CODE_L,
+)
+
+_LOGGER = logging.getLogger(__name__)
+
+# Every off-grid / EPS operating state has bit 6 or bit 7 set (64, 96, 128, 136, 192)
+OFF_GRID_STATE_MASK = 0xC0
+
+# Registers whose change on its own justifies a burst
+FAULT_WARNING_REGISTERS = {
+    I_INTERNAL_FAULT: "internal fault",
+    I_FAULT_CODE_L: "fault code",
+    I_FAULT_CODE_H: "fault code",
+    I_WARNING_CODE_L: "warning code",
+    I_WARNING_CODE_H: "warning code",
+}
+
+
+def is_off_grid(state) -> bool:
+    """Return True if the inverter state code is one of the off-grid (EPS) states."""
+    return state is not None and bool(state & OFF_GRID_STATE_MASK)
+
+
+class BurstTrigger:
+    """Compares successive input register sets and reports burst-worthy transitions.
+
+    Only the watched registers are remembered between polls, so detection stays
+    cheap even when it runs on every fast-tier cycle.
+    """
+
+    def __init__(self):
+        """Initialize the trigger without a baseline."""
+        self._previous = None
+
+    def reset(self) -> None:
+        """Forget the baseline, e.g. after a reconnect with stale data."""
+        self._previous = None
+
+    def detect(self, input_regs: dict) -> str | None:
+        """Return a short reason if a transition happened since the last call, else None.
+
+        The first call only records a baseline: a value seen for the first time
+        is not a transition.
+        """
+        current = {reg: input_regs.get(reg) for reg in (I_STATE, *FAULT_WARNING_REGISTERS)}
+        previous = self._previous
+        self._previous = current
+
+        if previous is None:
+            return None
+
+        prev_state, state = previous[I_STATE], current[I_STATE]
+        if prev_state is not None and state is not None and is_off_grid(prev_state) != is_off_grid(state):
+            return "entered off-grid" if is_off_grid(state) else "returned to grid"
+
+        for reg, label in FAULT_WARNING_REGISTERS.items():
+            if previous[reg] is not None and current[reg] is not None and previous[reg] != current[reg]:
+                return f"{label} changed ({previous[reg]} -> {current[reg]})"
+
+        return None
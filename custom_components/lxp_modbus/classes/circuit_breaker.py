@@ -0,0 +1,141 @@
+"""Circuit breaker guarding all traffic to a single WiFi dongle."""
+import logging
+import random
+import time as time_lib
+
+from ..const import BREAKER_BASE_DELAY, BREAKER_JITTER, BREAKER_MAX_DELAY
+
+_LOGGER = logging.getLogger(__name__)
+
+STATE_CLOSED = "closed"
+STATE_OPEN = "open"
+STATE_HALF_OPEN = "half_open"
+
+
+class CircuitOpenError(Exception):
+    """Raised when a request is rejected because the dongle circuit is open."""
+
+
+class DongleCircuitBreaker:
+    """Closed/open/half-open circuit breaker with jittered exponential backoff.
+
+    - closed: requests flow normally; consecutive failures are counted.
+    - open: after failure_threshold consecutive failures every request is
+      rejected immediately until the backoff delay has elapsed.
+    - half_open: exactly one probe request is let through. Its success closes
+      the circuit, its failure re-opens it with a doubled delay.
+
+    The breaker never sleeps: callers ask allow_request() and skip the dongle
+    when it returns False, so nothing waits on the client lock during an outage.
+    """
+
+    def __init__(self, failure_threshold: int, base_delay: float = BREAKER_BASE_DELAY,
+                 max_delay: float = BREAKER_MAX_DELAY, jitter: float = BREAKER_JITTER,
+                 clock=time_lib.monotonic, rng=random.random):
+        """Initialize the breaker in the closed state."""
+        self._failure_threshold = max(1, failure_threshold)
+        self._base_delay = base_delay
+        self._max_delay = max_delay
+        self._jitter = jitter
+        self._clock = clock
+        self._rng = rng
+
+        self._state = STATE_CLOSED
+        self._consecutive_failures = 0
+        self._open_count = 0
+        self._open_until = 0.0
+        self._current_delay = 0.0
+        self._probe_in_flight = False
+        self._rejected_requests = 0
+        self._times_opened = 0
+        self._last_failure = None
+
+    @property
+    def state(self) -> str:
+        """Return the current state, promoting open to half-open once the delay has passed."""
+        if self._state == STATE_OPEN and self._clock() >= self._open_until:
+            self._state = STATE_HALF_OPEN
+            self._probe_in_flight = False
+        return self._state
+
+    @property
+    def retry_in(self) -> float:
+        """Seconds until the next request will be allowed (0 when allowed now)."""
+        if self.state != STATE_OPEN:
+            return 0.0
+        return max(0.0, self._open_until - self._clock())
+
+    @property
+    def failure_threshold(self) -> int:
+        return self._failure_threshold
+
+    @failure_threshold.setter
+    def failure_threshold(self, value: int) -> None:
+        self._failure_threshold = max(1, value)
+
+    def allow_request(self) -> bool:
+        """Return True if a request may be sent to the dongle now.
+
+        In half-open state the first caller becomes the probe; everyone else is
+        rejected until the probe reports back via record_success/record_failure,
+        or gives up without an outcome via release_probe.
+        """
+        state = self.state
+        if state == STATE_CLOSED:
+            return True
+        if state == STATE_HALF_OPEN and not self._probe_in_flight:
+            _LOGGER.info("Dongle circuit half-open: sending probe request")
+            self._probe_in_flight = True
+            return True
+        self._rejected_requests += 1
+        return False
+
+    def release_probe(self) -> None:
+        """Let the next caller probe again after a probe ended without an outcome, e.g. on cancellation."""
+        self._probe_in_flight = False
+
+    def record_success(self) -> None:
+        """Record a successful exchange with the dongle and close the circuit."""
+        if self._state != STATE_CLOSED:
+            _LOGGER.info("Dongle circuit closed: connection restored after %s consecutive failures",
+                         self._consecutive_failures)
+        self._state = STATE_CLOSED
+        self._consecutive_failures = 0
+        self._open_count = 0
+        self._current_delay = 0.0
+        self._probe_in_flight = False
+
+    def record_failure(self, reason=None) -> None:
+        """Record a failed exchange; opens the circuit once the threshold is reached."""
+        self._consecutive_failures += 1
+        self._last_failure = str(reason) if reason is not None else None
+        self._probe_in_flight = False
+
+        if self._state == STATE_HALF_OPEN or (
+                self._state == STATE_CLOSED and self._consecutive_failures >= self._failure_threshold):
+            self._open()
+
+    def _open(self) -> None:
+        """Open the circuit for the next jittered exponential backoff delay."""
+        self._open_count += 1
+        self._times_opened += 1
+        delay = min(self._max_delay, self._base_delay * (2 ** (self._open_count - 1)))
+        delay *= 1 + self._jitter * (2 * self._rng() - 1)
+        self._current_delay = delay
+        self._open_until = self._clock() + delay
+        self._state = STATE_OPEN
+        _LOGGER.warning("Dongle circuit open after %s consecutive failures (last: %s). Next attempt in %.1fs",
+                        self._consecutive_failures, self._last_failure, delay)
+
+    def as_dict(self) -> dict:
+        """Return the breaker state for diagnostics."""
+        return {
+            "state": self.state,
+            "consecutive_failures": self._consecutive_failures,
+            "failure_threshold": self._failure_threshold,
+            "retry_in": round(self.retry_in, 1),
+            "current_backoff": round(self._current_delay, 1),
+            "times_opened": self._times_opened,
+            "rejected_requests": self._rejected_requests,
+            "last_failure": self._last_failure,
+        }
@@ -3,6 +3,7 @@ import asyncio
 import logging
 from contextlib import suppress
 
+from .frame_trace import DIRECTION_RX, FrameTrace
 from .lxp_response import LxpResponse
 
 _LOGGER = logging.getLogger(__name__)
@@ -18,12 +19,13 @@ class ModbusConnectionManager:
     """Manages TCP connection lifecycle for Modbus communication."""
 
     def __init__(self, host: str, port: int, connection_retries: int,
-                 skip_initial_data: bool = True):
-        """Initialize the connection manager."""
+                 skip_initial_data: bool = True, frame_trace: FrameTrace | None = None):
+        """Initialize the connection manager; discarded start data is added to frame_trace."""
         self._host = host
         self._port = port
         self._connection_retries = connection_retries
         self._skip_initial_data = skip_initial_data
+        self._frame_trace = frame_trace
 
     @property
     def host(self) -> str:
@@ -65,5 +67,7 @@ class ModbusConnectionManager:
                 timeout=INITIAL_DATA_TIMEOUT
             )
             if ignored:
-                response = LxpResponse(ignored)
-                _LOGGER.debug("ignored start data from dongle response=%s %s", response.info, ignored.hex())
+                if self._frame_trace is not None:
+                    self._frame_trace.record(DIRECTION_RX, ignored, "discarded start data")
+                if _LOGGER.isEnabledFor(logging.DEBUG):
+                    _LOGGER.debug("ignored start data from dongle response=%s", LxpResponse(ignored).info)
@@ -34,11 +34,15 @@ def is_data_sane(registers: dict, register_type: str) -> bool:
     time_registers = HOLD_TIME_REGISTERS if register_type == "hold" else INPUT_TIME_REGISTERS
 
     for register, value in registers.items():
-        if register in time_registers:
-            # The value is packed as Hour | (Minute << 8)
-            hour = value & 0xFF
-            minute = (value >> 8) & 0xFF
-            if not (0 <= hour <= 23 and 0 <= minute <= 59):
-                _LOGGER.debug("Sanity check failed for %s register %s value: %s: H=%s, M=%s", register_type, register, value, hour, minute)
-                return False
+        if register in time_registers and not is_time_value_sane(value):
+            _LOGGER.debug("Sanity check failed for %s register %s value: %s: H=%s, M=%s",
+                          register_type, register, value, value & 0xFF, (value >> 8) & 0xFF)
+            return False
     return True
+
+
+def is_time_value_sane(value: int) -> bool:
+    """Check a time register value, packed as Hour | (Minute << 8)."""
+    hour = value & 0xFF
+    minute = (value >> 8) & 0xFF
+    return 0 <= hour <= 23 and 0 <= minute <= 59
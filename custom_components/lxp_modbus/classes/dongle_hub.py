@@ -0,0 +1,108 @@
+"""Registry of dongle sessions shared by all config entries on the same host and port."""
+import logging
+
+from ..const import DEFAULT_CONNECTION_RETRIES
+from .circuit_breaker import DongleCircuitBreaker
+from .io_scheduler import PrioritySemaphore
+from .lxp_response import LxpResponse
+
+_LOGGER = logging.getLogger(__name__)
+
+
+class DongleSession:
+    """State shared by every inverter reached through one dongle.
+
+    The lock admits one connection to the dongle at a time, so parallel
+    inverters and duplicate entries no longer compete for it. Waiting writes
+    go first; polls are admitted in arrival order, which keeps the inverters'
+    turns fair. The
+    circuit breaker pauses all of them together during an outage, and frames
+    answering one inverter's request are handed to the client of the inverter
+    they belong to. Inverters are registered per config entry, so two entries
+    of the same inverter both receive its frames and unloading one of them
+    keeps routing to the other.
+
+    The breaker opens after the largest connection retries setting of the
+    registered inverters, so no entry's dongle is paused earlier than its own
+    setting allows.
+    """
+
+    def __init__(self, host: str, port: int):
+        """Initialize an unused session."""
+        self.host = host
+        self.port = port
+        self.lock = PrioritySemaphore()
+        self.circuit_breaker = DongleCircuitBreaker(DEFAULT_CONNECTION_RETRIES)
+        self._handlers = {}  # entry_id -> (inverter serial (bytes), callable(LxpResponse))
+        self._connection_retries = {}  # entry_id -> connection retries of the entry
+        self.routed_frames = 0
+
+    @property
+    def inverters(self) -> list[str]:
+        serials = dict.fromkeys(serial for serial, _ in self._handlers.values())
+        return [serial.decode(errors="replace") for serial in serials]
+
+    @property
+    def used(self) -> bool:
+        return bool(self._handlers)
+
+    def register(self, entry_id: str, inverter_serial: str, frame_handler, connection_retries: int) -> None:
+        """Receive frames for the entry's inverter that arrive on other clients' requests."""
+        if self._handlers:
+            _LOGGER.info("Sharing dongle %s:%s with inverter(s) %s", self.host, self.port, ", ".join(self.inverters))
+        self._handlers[entry_id] = (inverter_serial.encode(), frame_handler)
+        self.set_connection_retries(entry_id, connection_retries)
+
+    def unregister(self, entry_id: str) -> None:
+        """Stop routing frames to the entry and drop its retries setting."""
+        self._handlers.pop(entry_id, None)
+        self._connection_retries.pop(entry_id, None)
+        self._apply_failure_threshold()
+
+    def set_connection_retries(self, entry_id: str, connection_retries: int) -> None:
+        """Update the entry's retries setting, e.g. after an options change."""
+        self._connection_retries[entry_id] = connection_retries
+        self._apply_failure_threshold()
+
+    def _apply_failure_threshold(self) -> None:
+        if self._connection_retries:
+            self.circuit_breaker.failure_threshold = max(self._connection_retries.values())
+
+    def route(self, response: LxpResponse) -> bool:
+        """Hand a frame to the clients of its inverter. Returns False if no entry polls that inverter."""
+        handlers = [handler for serial, handler in self._handlers.values() if serial == response.serial_number]
+        if not handlers:
+            return False
+        self.routed_frames += 1
+        for handler in handlers:
+            handler(response)
+        return True
+
+
+class DongleHub:
+    """Hands out one DongleSession per (host, port) and drops it with its last inverter."""
+
+    def __init__(self):
+        """Initialize an empty hub."""
+        self._sessions = {}
+
+    def acquire(self, host: str, port: int) -> DongleSession:
+        """Return the session for the dongle, creating it for its first inverter."""
+        key = (host, port)
+        session = self._sessions.get(key)
+        if session is None:
+            session = self._sessions[key] = DongleSession(host, port)
+        return session
+
+    def release(self, session: DongleSession, entry_id: str) -> None:
+        """Unregister the entry; the session is dropped once no entry uses it."""
+        session.unregister(entry_id)
+        if not session.used:
+            self._sessions.pop((session.host, session.port), None)
+
+    def get_stats(self) -> list[dict]:
+        """Return the sessions with their inverters, for diagnostics."""
+        return [
+            {"host": s.host, "port": s.port, "inverters": s.inverters, "routed_frames": s.routed_frames}
+            for s in self._sessions.values()
+        ]
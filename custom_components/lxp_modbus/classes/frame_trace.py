@@ -0,0 +1,94 @@
+"""Bounded in-memory trace of the raw frames exchanged with the dongle."""
+import time as time_lib
+from collections import deque
+
+from ..const import BATTERY_BLOCK_REGISTERS, BATTERY_INFO_START_REGISTER, FRAME_TRACE_SIZE
+from ..constants.battery_registers import B_SERIAL_START
+from .lxp_request_builder import LxpRequestBuilder
+from .poll_plan import INPUT_FUNCTION_CODE
+
+DIRECTION_TX = "tx"
+DIRECTION_RX = "rx"
+
+# Byte ranges of the serial numbers, relative to the start of a packet
+DONGLE_SERIAL_BYTES = (8, 18)
+INVERTER_SERIAL_BYTES = (22, 32)  # only in translated data packets
+# Register count, start register and values of read responses (protocol 2 and 5)
+RESPONSE_PROTOCOLS = (2, 5)
+RESPONSE_REGISTER_BYTES = (32, 34)
+RESPONSE_VALUE_START = 35
+# Registers holding the serial number within each battery pack block (as dropped by LxpBatteries)
+BATTERY_SERIAL_REGISTERS = range(B_SERIAL_START, 27)
+
+
+def _battery_serial_ranges(frame: bytes, start: int) -> list[tuple[int, int]]:
+    """Return the byte ranges of the pack serials in a battery page response starting at start."""
+    if len(frame) < start + RESPONSE_VALUE_START or frame[start + 21] != INPUT_FUNCTION_CODE \
+            or int.from_bytes(frame[start + 2:start + 4], 'little') not in RESPONSE_PROTOCOLS:
+        return []
+    register = int.from_bytes(frame[start + RESPONSE_REGISTER_BYTES[0]:start + RESPONSE_REGISTER_BYTES[1]], 'little')
+    if register < BATTERY_INFO_START_REGISTER:
+        return []
+    values = start + RESPONSE_VALUE_START
+    value_end = min(values + frame[start + RESPONSE_VALUE_START - 1], len(frame))
+    return [
+        (offset, min(offset + 2, value_end))
+        for offset in range(values, value_end, 2)
+        if (register + (offset - values) // 2 - BATTERY_INFO_START_REGISTER) % BATTERY_BLOCK_REGISTERS
+        in BATTERY_SERIAL_REGISTERS
+    ]
+
+
+def _serial_ranges(frame: bytes) -> list[tuple[int, int]]:
+    """Return the byte ranges holding serial numbers in every packet contained in the frame."""
+    ranges = []
+    start = frame.find(LxpRequestBuilder.PREFIX)
+    while start != -1:
+        ranges.append((start + DONGLE_SERIAL_BYTES[0], start + DONGLE_SERIAL_BYTES[1]))
+        if len(frame) > start + 7 and frame[start + 7] == LxpRequestBuilder.TRANSLATED_DATA:
+            ranges.append((start + INVERTER_SERIAL_BYTES[0], start + INVERTER_SERIAL_BYTES[1]))
+            ranges.extend(_battery_serial_ranges(frame, start))
+        start = frame.find(LxpRequestBuilder.PREFIX, start + 1)
+    return ranges
+
+
+def _masked_hex(frame: bytes) -> str:
+    """Return the frame as hex with the serial number bytes (dongle, inverter, battery packs) replaced by '**'."""
+    hex_bytes = [f"{byte:02x}" for byte in frame]
+    for start, end in _serial_ranges(frame):
+        hex_bytes[start:end] = ["**"] * len(hex_bytes[start:end])
+    return "".join(hex_bytes)
+
+
+class FrameTrace:
+    """Ring buffer of the most recent raw frames (timestamp, direction, bytes).
+
+    Recording only stores a reference to the frame bytes, so tracing costs
+    nothing measurable on the poll path; frames are converted to hex only
+    when the trace is dumped (diagnostics download or the dump_frames service).
+    """
+
+    def __init__(self, size: int = FRAME_TRACE_SIZE, clock=time_lib.time):
+        """Initialize an empty trace keeping at most size frames."""
+        self._frames = deque(maxlen=size)
+        self._clock = clock
+
+    def record(self, direction: str, frame: bytes | None, note: str | None = None) -> None:
+        """Add a frame; an empty or missing frame records that nothing was received."""
+        self._frames.append((self._clock(), direction, bytes(frame or b""), note))
+
+    def __len__(self) -> int:
+        return len(self._frames)
+
+    def dump(self, mask_serials: bool = False) -> list[dict]:
+        """Return the traced frames, oldest first, with the bytes as hex strings.
+
+        With mask_serials the dongle, inverter and battery pack serial numbers are masked, so the
+        trace can be shared (it is part of the diagnostics download).
+        """
+        return [
+            {"time": timestamp, "direction": direction, "length": len(frame),
+             "frame": _masked_hex(frame) if mask_serials else frame.hex(),
+             **({"note": note} if note else {})}
+            for timestamp, direction, frame, note in self._frames
+        ]
@@ -0,0 +1,130 @@
+"""Process-wide limit on concurrent dongle operations across all config entries."""
+import asyncio
+import heapq
+import itertools
+import logging
+import time as time_lib
+from collections import deque
+from contextlib import asynccontextmanager
+
+from ..const import IO_MAX_CONCURRENT, IO_POLL_STAGGER, IO_THROUGHPUT_WINDOW
+
+_LOGGER = logging.getLogger(__name__)
+
+PRIORITY_WRITE = 0
+PRIORITY_POLL = 1
+
+
+class PrioritySemaphore:
+    """Admits at most max_concurrent holders at a time, queueing the others by priority, then arrival.
+
+    With max_concurrent=1 it is the lock of one dongle: a write queued behind
+    polls of the same dongle goes next, while polls keep their arrival order.
+    """
+
+    def __init__(self, max_concurrent: int = 1):
+        """Initialize an idle semaphore."""
+        self.max_concurrent = max_concurrent
+        self._in_flight = 0
+        self._waiters = []  # heap of (priority, sequence, future)
+        self._sequence = itertools.count()
+        self._max_queue_depth = 0
+
+    @asynccontextmanager
+    async def hold(self, priority: int = PRIORITY_POLL):
+        """Hold one of the slots for the duration of the block."""
+        await self._async_acquire(priority)
+        try:
+            yield
+        finally:
+            self._release()
+
+    async def _async_acquire(self, priority: int) -> None:
+        if self._in_flight < self.max_concurrent and not self._waiters:
+            self._in_flight += 1
+            return
+
+        waiter = (priority, next(self._sequence), asyncio.get_running_loop().create_future())
+        heapq.heappush(self._waiters, waiter)
+        self._max_queue_depth = max(self._max_queue_depth, len(self._waiters))
+        try:
+            await waiter[2]
+        except asyncio.CancelledError:
+            if waiter in self._waiters:
+                self._waiters.remove(waiter)
+                heapq.heapify(self._waiters)
+            elif not waiter[2].cancelled():
+                # The slot was handed over just before the cancellation; pass it on
+                self._release()
+            raise
+
+    def _release(self) -> None:
+        """Hand the slot to the next waiter or free it."""
+        while self._waiters:
+            future = heapq.heappop(self._waiters)[2]
+            if not future.done():
+                future.set_result(None)
+                return
+        self._in_flight -= 1
+
+
+class IoScheduler(PrioritySemaphore):
+    """Admits at most max_concurrent dongle operations at a time, writes before polls.
+
+    Each client wraps its locked dongle sessions in slot(). When all slots are
+    taken, callers queue by priority and then arrival order, so a setting
+    change never waits behind the polls of other inverters. It also hands out
+    staggered first-poll delays so entries set up together do not poll in step.
+    """
+
+    def __init__(self, max_concurrent: int = IO_MAX_CONCURRENT, stagger: float = IO_POLL_STAGGER,
+                 clock=time_lib.monotonic):
+        """Initialize an idle scheduler."""
+        super().__init__(max_concurrent)
+        self._stagger = stagger
+        self._clock = clock
+        self._completed = deque()  # completion times within IO_THROUGHPUT_WINDOW
+        self._operations = 0
+        self._entries = []
+
+    def register(self, entry_id: str) -> float:
+        """Add an entry and return how long its first poll should wait."""
+        if entry_id not in self._entries:
+            self._entries.append(entry_id)
+        return self._entries.index(entry_id) * self._stagger
+
+    def unregister(self, entry_id: str) -> None:
+        if entry_id in self._entries:
+            self._entries.remove(entry_id)
+
+    @asynccontextmanager
+    async def slot(self, priority: int = PRIORITY_POLL):
+        """Hold one of the concurrent operation slots for the duration of the block."""
+        await self._async_acquire(priority)
+        try:
+            yield
+        finally:
+            now = self._clock()
+            self._completed.append(now)
+            self._trim_completed(now)
+            self._operations += 1
+            self._release()
+
+    def _trim_completed(self, now: float) -> None:
+        """Drop completion times that left the throughput window, keeping the deque bounded."""
+        while self._completed and now - self._completed[0] > IO_THROUGHPUT_WINDOW:
+            self._completed.popleft()
+
+    def get_stats(self) -> dict:
+        """Return load statistics for diagnostics."""
+        self._trim_completed(self._clock())
+        return {
+            "max_concurrent": self.max_concurrent,
+            "in_flight": self._in_flight,
+            "queue_depth": len(self._waiters),
+            "queued_writes": sum(1 for waiter in self._waiters if waiter[0] == PRIORITY_WRITE),
+            "max_queue_depth": self._max_queue_depth,
+            "operations": self._operations,
+            "operations_per_minute": round(len(self._completed) * 60 / IO_THROUGHPUT_WINDOW, 1),
+            "entries": len(self._entries),
+        }
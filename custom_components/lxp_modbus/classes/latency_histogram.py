@@ -0,0 +1,66 @@
+"""Fixed-memory latency histograms for dongle timing diagnostics."""
+import math
+
+from ..const import LATENCY_BUCKETS_PER_OCTAVE, LATENCY_MAX_MS, LATENCY_MIN_MS
+
+
+class LatencyHistogram:
+    """Counts durations in logarithmic buckets and estimates percentiles from them.
+
+    Bucket bounds grow by a constant factor from LATENCY_MIN_MS to LATENCY_MAX_MS,
+    so memory stays fixed no matter how many samples are recorded and every
+    percentile is accurate to within one bucket (about 19% with 4 buckets per
+    octave). Percentiles are reported as the upper bound of their bucket,
+    capped at the largest duration seen.
+    """
+
+    def __init__(self, min_ms: float = LATENCY_MIN_MS, max_ms: float = LATENCY_MAX_MS,
+                 buckets_per_octave: int = LATENCY_BUCKETS_PER_OCTAVE):
+        """Initialize an empty histogram."""
+        self._min_ms = min_ms
+        self._factor = 2 ** (1 / buckets_per_octave)
+        # The last bucket collects everything above max_ms
+        self._counts = [0] * (math.ceil(math.log(max_ms / min_ms, self._factor)) + 2)
+        self._count = 0
+        self._max_ms = 0.0
+
+    @property
+    def count(self) -> int:
+        return self._count
+
+    def _bucket(self, ms: float) -> int:
+        if ms <= self._min_ms:
+            return 0
+        return min(len(self._counts) - 1, math.ceil(math.log(ms / self._min_ms, self._factor)))
+
+    def record(self, seconds: float) -> None:
+        """Add one duration in seconds."""
+        ms = max(0.0, seconds * 1000)
+        self._counts[self._bucket(ms)] += 1
+        self._count += 1
+        self._max_ms = max(self._max_ms, ms)
+
+    def percentile(self, quantile: float) -> float | None:
+        """Return the estimated duration in milliseconds below which the quantile of samples fall."""
+        if not self._count:
+            return None
+        rank = quantile * self._count
+        seen = 0
+        for index, count in enumerate(self._counts):
+            seen += count
+            if seen >= rank and count:
+                break
+        if index == len(self._counts) - 1:
+            # The overflow bucket has no upper bound
+            return round(self._max_ms, 1)
+        return round(min(self._min_ms * self._factor ** index, self._max_ms), 1)
+
+    def get_stats(self) -> dict:
+        """Return the sample count, p50/p95/p99 and maximum in milliseconds."""
+        return {
+            "count": self._count,
+            "p50": self.percentile(0.50),
+            "p95": self.percentile(0.95),
+            "p99": self.percentile(0.99),
+            "max": round(self._max_ms, 1) if self._count else None,
+        }
@@ -8,6 +8,8 @@ class LxpRequestBuilder:
     TRANSLATED_DATA = 194
     ACTION_WRITE = 0
     WRITE_SINGLE = 6
+    WRITE_MULTI = 16
+    PROTOCOL_WRITE_MULTI = 2
 
     @staticmethod
     def prepare_packet_for_read(
@@ -66,4 +68,40 @@ class LxpRequestBuilder:
         data_frame = bytes(buf[20:36])  # always 16 bytes
         crc = LxpPacketUtils.compute_crc(data_frame)
         buf += crc.to_bytes(2, 'little')
-        return bytes(buf)
\ No newline at end of file
+        return bytes(buf)
+
+    @staticmethod
+    def prepare_packet_for_write_multi(
+        dongle_serial: bytes, serial_number: bytes, start_register: int, values: list[int]
+    ) -> bytes:
+        if len(dongle_serial) != 10:
+            raise ValueError("dongle_serial must be 10 bytes")
+        if len(serial_number) != 10:
+            raise ValueError("serial_number must be 10 bytes")
+        if not values:
+            raise ValueError("values must not be empty")
+
+        data = bytearray()
+        data += LxpRequestBuilder.ACTION_WRITE.to_bytes(1, 'little')
+        data += LxpRequestBuilder.WRITE_MULTI.to_bytes(1, 'little')
+        data += serial_number
+        data += start_register.to_bytes(2, 'little')
+        data += len(values).to_bytes(2, 'little')
+        data += (len(values) * 2).to_bytes(1, 'little')
+        for value in values:
+            data += (value & 0xFFFF).to_bytes(2, 'little')
+
+        data_length = len(data) + 2  # data frame plus crc
+        buf = bytearray()
+        buf += LxpRequestBuilder.PREFIX
+        buf += LxpRequestBuilder.PROTOCOL_WRITE_MULTI.to_bytes(2, 'little')
+        buf += (data_length + 14).to_bytes(2, 'little')
+        buf += (1).to_bytes(1, 'little')
+        buf += LxpRequestBuilder.TRANSLATED_DATA.to_bytes(1, 'little')
+        buf += dongle_serial
+        buf += data_length.to_bytes(2, 'little')
+        buf += data
+
+        crc = LxpPacketUtils.compute_crc(bytes(data))
+        buf += crc.to_bytes(2, 'little')
+        return bytes(buf)
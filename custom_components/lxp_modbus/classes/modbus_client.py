@@ -2,29 +2,49 @@
 import asyncio
 import logging
 import time as time_lib
+from contextlib import asynccontextmanager
 
 from homeassistant.helpers.update_coordinator import UpdateFailed
 
 from ..const import (
     BATTERY_INFO_START_REGISTER,
     DEFAULT_CONNECTION_RETRIES,
-    INITIAL_RETRY_DELAY,
+    DEFAULT_WRITE_DEBOUNCE,
+    IDENTITY_HOLD_COUNT,
+    IDENTITY_HOLD_START,
+    LATENCY_BLOCK,
+    LATENCY_CONNECT,
+    LATENCY_CYCLE,
+    LATENCY_QUEUE_WAIT,
+    LATENCY_WRITE,
     MAX_CACHED_DATA_FAILURES,
     MAX_EMPTY_DATA_FAILURES,
+    MULTI_WRITE_MAX_REGISTERS,
     READ_TIMEOUT,
     RESPONSE_OVERHEAD,
-    RETRY_BACKOFF_MULTIPLIER,
+    TIER_SLOW,
     TOTAL_REGISTERS,
     WRITE_RESPONSE_LENGTH,
     WRITE_RETRY_DELAY,
+    WRITE_SKIP_MAX_AGE,
 )
 from ..constants.input_registers import I_BAT_PARALLEL_NUM
+from ..utils import contiguous_runs
+from .battery_schedule import BatterySchedule
+from .bitfield_writer import REGISTER_MASK, BitfieldWriteBatcher
+from .circuit_breaker import STATE_OPEN, CircuitOpenError, DongleCircuitBreaker
 from .connection_manager import ModbusConnectionManager
 from .data_validator import is_data_sane
+from .frame_trace import DIRECTION_RX, DIRECTION_TX, FrameTrace
+from .io_scheduler import PRIORITY_POLL, PRIORITY_WRITE, IoScheduler, PrioritySemaphore
+from .latency_histogram import LatencyHistogram
 from .lxp_batteries import LxpBatteries
 from .lxp_request_builder import LxpRequestBuilder
 from .lxp_response import LxpResponse
 from .packet_recovery import PacketRecoveryHandler
+from .poll_plan import HOLD_FUNCTION_CODE, INPUT_FUNCTION_CODE, build_battery_pages, build_poll_plan
+from .poll_scheduler import PollScheduler
+from .write_journal import SOURCE_ACK, SOURCE_READ, WriteJournal
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -37,32 +57,207 @@ class LxpModbusApiClient:
 
     Orchestrates register reading and writing using composed dependencies:
     - ModbusConnectionManager: TCP connection lifecycle
+    - DongleCircuitBreaker: Backoff for polls and writes during dongle outages
+    - IoScheduler: Integration-wide limit on concurrent dongle sessions, writes first
+    - PollScheduler: Per-cycle block selection within the poll budget
+    - BitfieldWriteBatcher: Batched read-modify-write of shared bitfield registers
+    - WriteJournal: Optimistic values of entity writes until the inverter confirms them
     - PacketRecoveryHandler: Malformed packet recovery
     - Data validation via is_data_sane()
     """
 
-    def __init__(self, host: str, port: int, dongle_serial: str, inverter_serial: str, lock: asyncio.Lock,
+    def __init__(self, host: str, port: int, dongle_serial: str, inverter_serial: str, lock: PrioritySemaphore,
                  block_size: int = 125, connection_retries: int = DEFAULT_CONNECTION_RETRIES,
-                 skip_initial_data: bool = True, request_battery_data: bool = False):
-        """Initialize the API client."""
+                 skip_initial_data: bool = True, request_battery_data: bool = False,
+                 poll_budget: float | None = None, write_debounce: float = DEFAULT_WRITE_DEBOUNCE / 1000,
+                 circuit_breaker: DongleCircuitBreaker | None = None, io_scheduler: IoScheduler | None = None):
+        """Initialize the API client.
+
+        lock and circuit_breaker may be shared with the clients of other
+        inverters behind the same dongle (see DongleHub), io_scheduler with
+        all clients of the integration.
+
+        poll_budget limits the seconds a full poll cycle may spend on the dongle;
+        slow-tier blocks that do not fit are rotated into later cycles.
+        write_debounce is the window in seconds during which successive number
+        writes to a register are coalesced into a write of the latest value.
+        """
         self._dongle_serial = dongle_serial
         self._inverter_serial = inverter_serial
         self._lock = lock
         self._block_size = block_size
         self._connection_retries = connection_retries
         self._request_battery_data = request_battery_data
+        self._write_debounce = write_debounce
         self._last_good_input_regs = {}
         self._last_good_hold_regs = {}
         self._last_good_battery_data = {}
+        self._data_is_stale = False
+        self._last_poll_live = False
+        self._last_poll_live_tiers = frozenset()
+        self._last_fast_tier_inputs = {}
+        self._last_fast_tier_read = None
+        self._confirmed_hold_regs = {}  # register -> (value, monotonic time confirmed by the inverter)
+        self._skipped_writes = 0
         self._connection_retry_count = 0
         self._last_successful_connection = None
         self._connection_failure_count = 0
+        self._poll_scheduler = PollScheduler(build_poll_plan(block_size), poll_budget)
+        self._battery_schedule = BatterySchedule()
+        self._latency = {
+            name: LatencyHistogram()
+            for name in (LATENCY_CONNECT, LATENCY_BLOCK, LATENCY_CYCLE, LATENCY_QUEUE_WAIT, LATENCY_WRITE)
+        }
 
         # Composed dependencies
+        self._frame_trace = FrameTrace()
         self._connection_manager = ModbusConnectionManager(
-            host, port, connection_retries, skip_initial_data
+            host, port, connection_retries, skip_initial_data, self._frame_trace
         )
         self._packet_recovery = PacketRecoveryHandler()
+        # A shared breaker is configured by its DongleSession, an own one by reconfigure
+        self._owns_circuit_breaker = circuit_breaker is None
+        self._circuit_breaker = circuit_breaker or DongleCircuitBreaker(connection_retries)
+        self._io_scheduler = io_scheduler or IoScheduler()
+        self._bit_writer = BitfieldWriteBatcher(self._async_write_masked)
+        self._write_journal = WriteJournal()
+        self._write_tasks = set()
+        # Called with (register, attempted value, restored value or None) when a submitted write resolves
+        self.on_write_resolved = None
+        # Called with frames for another inverter that arrive on this client's session
+        self.on_foreign_frame = None
+        # Called with (added serials, removed serials) when battery packs appear or disappear
+        self.on_battery_change = None
+        self._routed_frames = 0
+
+    @property
+    def circuit_breaker(self) -> DongleCircuitBreaker:
+        """Return the circuit breaker guarding this dongle."""
+        return self._circuit_breaker
+
+    def reconfigure(self, block_size: int | None = None, connection_retries: int | None = None,
+                    poll_budget: float | None = None, write_debounce: float | None = None) -> None:
+        """Apply new polling parameters to the live client.
+
+        Takes effect from the next poll or write; a changed block size recompiles
+        the poll plan (learned block read times start over).
+        """
+        if block_size is not None and block_size != self._block_size:
+            _LOGGER.info("Register block size changed from %s to %s", self._block_size, block_size)
+            self._block_size = block_size
+            previous = self._poll_scheduler
+            self._poll_scheduler = PollScheduler(build_poll_plan(block_size), previous.budget)
+            for key, registers in previous.pinned.items():
+                self._poll_scheduler.pin(key, registers)
+        if connection_retries is not None:
+            self._connection_retries = connection_retries
+            if self._owns_circuit_breaker:
+                self._circuit_breaker.failure_threshold = connection_retries
+        if poll_budget is not None:
+            self._poll_scheduler.budget = poll_budget
+        if write_debounce is not None:
+            self._write_debounce = write_debounce
+
+    @property
+    def data_is_stale(self) -> bool:
+        """Return True while the data comes from a restored snapshot rather than a live poll."""
+        return self._data_is_stale
+
+    @property
+    def last_poll_live(self) -> bool:
+        """Return True if the last async_get_data() read live registers rather than falling back to cached data."""
+        return self._last_poll_live
+
+    @property
+    def last_poll_live_tiers(self) -> frozenset:
+        """Return the tiers whose blocks were all read live in the last async_get_data(); empty after a timeout."""
+        return self._last_poll_live_tiers
+
+    @property
+    def last_fast_tier_inputs(self) -> dict:
+        """Return the fast-tier input registers (pinned ones included) read live in the last async_get_data()."""
+        return self._last_fast_tier_inputs
+
+    @property
+    def last_fast_tier_read(self) -> float | None:
+        """Return the monotonic time the last async_get_data() finished reading the fast tier, None if it did not."""
+        return self._last_fast_tier_read
+
+    def pin_fast_registers(self, key: str, registers) -> None:
+        """Read input registers on every fast-tier poll for consumer key (see PollScheduler.pin)."""
+        self._poll_scheduler.pin(key, registers)
+
+    def unpin_fast_registers(self, key: str) -> None:
+        self._poll_scheduler.unpin(key)
+
+    def restore_snapshot(self, snapshot: dict) -> dict:
+        """Seed the last known good data from a persisted snapshot and return it.
+
+        The data is marked stale until the first poll that reads live registers.
+        """
+        self._last_good_input_regs.update(snapshot.get("input", {}))
+        self._last_good_hold_regs.update(snapshot.get("hold", {}))
+        self._last_good_battery_data.update(snapshot.get("battery", {}))
+        self._battery_schedule.restore(self._last_good_battery_data)
+        self._data_is_stale = True
+        return self.cached_data
+
+    @property
+    def cached_data(self) -> dict:
+        """Return the last known good dataset, shaped like the result of async_get_data()."""
+        return {"input": self._last_good_input_regs, "hold": self._last_good_hold_regs, "battery": self._last_good_battery_data}
+
+    def battery_is_fresh(self, serial: str) -> bool:
+        """Return True while the battery pack's own data has not expired."""
+        return self._battery_schedule.is_fresh(serial)
+
+    @property
+    def frame_trace(self) -> FrameTrace:
+        """Return the ring buffer of recent raw frames exchanged with the dongle."""
+        return self._frame_trace
+
+    @property
+    def poll_scheduler(self) -> PollScheduler:
+        """Return the scheduler selecting the blocks of each poll cycle."""
+        return self._poll_scheduler
+
+    @asynccontextmanager
+    async def _session(self, priority: int):
+        """Hold the dongle lock and a global I/O slot for one connect/request/close session.
+
+        Both admit writes before queued polls, so a write waits for at most the
+        session in progress on its dongle.
+        """
+        requested = time_lib.monotonic()
+        async with self._lock.hold(priority):
+            async with self._io_scheduler.slot(priority):
+                self._latency[LATENCY_QUEUE_WAIT].record(time_lib.monotonic() - requested)
+                yield
+
+    async def _async_connect(self):
+        """Open a connection to the dongle through the circuit breaker.
+
+        Raises CircuitOpenError without touching the network while the circuit
+        is open (or another caller holds the half-open probe).
+        """
+        if not self._circuit_breaker.allow_request():
+            raise CircuitOpenError(
+                f"dongle circuit is {self._circuit_breaker.state}, "
+                f"next attempt in {self._circuit_breaker.retry_in:.0f}s"
+            )
+        started = time_lib.monotonic()
+        try:
+            reader, writer = await self._connection_manager.async_connect()
+        except asyncio.CancelledError:
+            # Neither outcome is known; another caller must be able to probe
+            self._circuit_breaker.release_probe()
+            raise
+        except Exception as e:
+            self._circuit_breaker.record_failure(e)
+            raise
+        self._latency[LATENCY_CONNECT].record(time_lib.monotonic() - started)
+        self._circuit_breaker.record_success()
+        return reader, writer
 
     async def async_safe_packet_recovery(self, reader, response_buf: bytes,
                                          expected_length: int, request_type: str,
@@ -72,28 +267,29 @@ class LxpModbusApiClient:
             reader, response_buf, expected_length, request_type, function_code
         )
 
-    async def async_request_registers(self, writer, reader, reg, request_type, function_code) -> dict:
+    async def async_request_registers(self, writer, reader, reg, request_type, function_code, count=None) -> dict:
         """Request a block of registers and return parsed values."""
-        count = min(self._block_size, TOTAL_REGISTERS - reg) if (reg < BATTERY_INFO_START_REGISTER) else self._block_size
+        if count is None:
+            count = min(self._block_size, TOTAL_REGISTERS - reg) if (reg < BATTERY_INFO_START_REGISTER) else self._block_size
         req = LxpRequestBuilder.prepare_packet_for_read(
             self._dongle_serial.encode(), self._inverter_serial.encode(),
             reg, count, function_code
         )
         expected_length = RESPONSE_OVERHEAD + (count * 2)
+        self._frame_trace.record(DIRECTION_TX, req)
         writer.write(req)
         await writer.drain()
         response_buf = await asyncio.wait_for(reader.read(expected_length), timeout=READ_TIMEOUT)
+        self._frame_trace.record(DIRECTION_RX, response_buf)
 
         _LOGGER.debug(
-            "Polling %s(%d) %d-%d: Req[%d]: %s, Resp[%d/%d]: %s",
+            "Polling %s(%d) %d-%d: Req[%d], Resp[%d/%d]",
             request_type,
             function_code,
             reg, reg + count - 1,
             len(req),
-            req.hex(),
             len(response_buf) if response_buf else 0,
             expected_length,
-            response_buf.hex() if response_buf else "None"
         )
 
         if response_buf and len(response_buf) > RESPONSE_OVERHEAD:
@@ -116,8 +312,8 @@ class LxpModbusApiClient:
                     _LOGGER.debug("%s(%s) response has different register count (%s) than requested (%s)",
                                   request_type, function_code, len(response.parsed_values_dictionary), count)
 
-                # Battery data needs special decoding — returns dict keyed by serial
-                # This will not work correctly with small blocks if they are not aligned
+                # Battery data needs special decoding — returns dict keyed by serial.
+                # Reads start on a 30-register pack boundary, so each page decodes on its own
                 if response.register >= BATTERY_INFO_START_REGISTER:
                     bat_dict = LxpBatteries(response).get_battery_info()
                     _LOGGER.debug("Battery data decoded: %s", list(bat_dict.keys()))
@@ -125,11 +321,84 @@ class LxpModbusApiClient:
 
                 return response.parsed_values_dictionary
             else:
+                if (not response.packet_error and self.on_foreign_frame is not None
+                        and response.serial_number != self._inverter_serial.encode()):
+                    # Answer to a request of another inverter behind the same dongle
+                    self.on_foreign_frame(response)
                 _LOGGER.debug("ignoring %s(%s) packet for regs %s-%s : response=%s",
                               request_type, function_code, reg, reg + count - 1, response.info)
 
         return {}
 
+    def accept_routed_frame(self, response: LxpResponse) -> None:
+        """Merge a frame for this inverter that arrived while another client polled the dongle."""
+        if response.device_function == INPUT_FUNCTION_CODE and response.register < BATTERY_INFO_START_REGISTER:
+            request_type, last_good = "input", self._last_good_input_regs
+        elif response.device_function == HOLD_FUNCTION_CODE:
+            request_type, last_good = "hold", self._last_good_hold_regs
+        else:
+            return
+        values = response.parsed_values_dictionary
+        if not values or not is_data_sane(values, request_type):
+            return
+        if request_type == "hold":
+            self._confirm_hold_regs(values)
+            values = self._reconcile_journal(values)
+        last_good.update(values)
+        self._routed_frames += 1
+        _LOGGER.debug("Merged %s registers %s-%s routed from another inverter's session",
+                      request_type, response.register, response.register + len(values) - 1)
+
+    async def _async_request_block(self, writer, reader, block) -> dict:
+        """Read one block of the poll plan and report its timing to the scheduler."""
+        started = time_lib.monotonic()
+        try:
+            reg_block = await self.async_request_registers(
+                writer, reader, block.start, block.register_type, block.function_code, block.count)
+        except asyncio.TimeoutError:
+            self._poll_scheduler.record_block(block, time_lib.monotonic() - started, False)
+            raise
+        elapsed = time_lib.monotonic() - started
+        self._poll_scheduler.record_block(block, elapsed, bool(reg_block))
+        self._latency[LATENCY_BLOCK].record(elapsed)
+        return reg_block
+
+    async def _async_poll_batteries(self, writer, reader, pack_count: int, merge) -> None:
+        """Read the due battery pages, paged in whole packs so any block size and bank size is covered."""
+        known = set(self._last_good_battery_data)
+        pages = build_battery_pages(self._block_size, pack_count)
+        self._battery_schedule.prune(pages)
+        for page in self._battery_schedule.due_pages(pages):
+            try:
+                bat_block = await self.async_request_registers(
+                    writer, reader, page.start, "input/bat", page.function_code, page.count)
+            except asyncio.TimeoutError:
+                # A late answer could be mistaken for the next page; the rest waits for the next cycle
+                self._battery_schedule.record_timeout(page)
+                break
+            self._battery_schedule.record_page(page, bat_block)
+            merge(bat_block)
+        self._update_battery_serials(known, pages)
+
+    def _update_battery_serials(self, known: set, pages: list) -> None:
+        """Report packs that appeared or disappeared since the previous battery poll.
+
+        A pack disappears once every current page has been read and none holds
+        its serial, e.g. after the pack count dropped (also to 0) or a pack was swapped.
+        """
+        added = set(self._last_good_battery_data) - known
+        removed = set()
+        if self._battery_schedule.covers(pages):
+            removed = known - self._battery_schedule.located
+            for serial in removed:
+                self._last_good_battery_data.pop(serial, None)
+                self._battery_schedule.forget(serial)
+        if not added and not removed:
+            return
+        _LOGGER.info("Battery packs changed: added %s, removed %s", sorted(added), sorted(removed))
+        if self.on_battery_change is not None:
+            self.on_battery_change(added, removed)
+
     async def async_discard_initial_data(self, reader):
         """Delegate initial data discard to the connection manager."""
         await self._connection_manager.async_discard_initial_data(reader)
@@ -138,97 +407,149 @@ class LxpModbusApiClient:
         """Get packet recovery statistics for monitoring and debugging."""
         return self._packet_recovery.get_stats()
 
-    async def async_get_data(self) -> dict:
-        """Fetch data from the inverter, backfilling with old data on partial failure."""
-        _LOGGER.debug("API Client: Polling the inverter for new data...")
+    async def async_read_identity(self) -> dict:
+        """Read only the firmware registers needed for the device info.
+
+        A single short request, so setup can register the device before the
+        first full poll has completed. Returns an empty dict on failure.
+        """
+        writer = None
+        try:
+            async with self._session(PRIORITY_POLL):
+                reader, writer = await self._async_connect()
+                await self._connection_manager.async_discard_initial_data(reader)
+                regs = await self.async_request_registers(
+                    writer, reader, IDENTITY_HOLD_START, "hold", HOLD_FUNCTION_CODE, IDENTITY_HOLD_COUNT)
+                await self._connection_manager.async_close(writer)
+                writer = None
+        except (asyncio.TimeoutError, OSError, CircuitOpenError) as e:
+            _LOGGER.warning("Could not read inverter identity registers: %s", e)
+            if writer:
+                await self._connection_manager.async_close(writer)
+            return {}
+
+        self._last_good_hold_regs.update(regs)
+        self._confirm_hold_regs(regs)
+        return regs
+
+    async def async_get_data(self, tiers=None, on_block=None) -> dict:
+        """Fetch data from the inverter, backfilling with old data on partial failure.
+
+        Args:
+            tiers: Register tiers to poll (e.g. only TIER_FAST during a burst).
+                   None polls every tier. Registers of skipped tiers keep their
+                   last known good values.
+            on_block: Optional callback receiving the merged dataset each time a
+                   block has been read, for populating entities progressively.
+        """
+        _LOGGER.debug("API Client: Polling the inverter for new data (tiers=%s)...", tiers or "all")
 
-        # Initialize connection state for this attempt
-        connection_success = False
-        connection_retry = False
-        retry_delay = INITIAL_RETRY_DELAY
         writer = None
+        data = self.cached_data
+        self._last_poll_live = False
+        self._last_poll_live_tiers = frozenset()
+        self._last_fast_tier_inputs = {}
+        self._last_fast_tier_read = None
+
+        def merge(newly_polled: dict, last_good: dict, reg_block: dict):
+            # Merge each block as it arrives so partial cycles are visible immediately
+            if len(reg_block) > 0:
+                newly_polled.update(reg_block)
+                last_good.update(reg_block)
+                if on_block is not None:
+                    on_block(data)
 
         try:
-            async with self._lock:
-                # Try to establish a connection with retry logic
-                for retry in range(self._connection_retries):
-                    try:
-                        if retry > 0:
-                            _LOGGER.info("Connection retry attempt %s/%s...", retry, self._connection_retries)
-                            connection_retry = True
-
-                        reader, writer = await self._connection_manager.async_connect()
-                        connection_success = True
-                        break
-                    except (asyncio.TimeoutError, ConnectionRefusedError, OSError) as e:
-                        if retry < self._connection_retries - 1:
-                            _LOGGER.warning("Connection attempt failed: %s. Retrying in %s seconds...", e, retry_delay)
-                            await asyncio.sleep(retry_delay)
-                            retry_delay *= RETRY_BACKOFF_MULTIPLIER
-                        else:
-                            raise
+            # Fail fast without queueing on the lock while the circuit is open
+            if self._circuit_breaker.state == STATE_OPEN:
+                raise CircuitOpenError(
+                    f"dongle circuit is open, next attempt in {self._circuit_breaker.retry_in:.0f}s")
+
+            async with self._session(PRIORITY_POLL):
+                cycle_start = time_lib.monotonic()
+
+                # A single attempt per cycle: the circuit breaker spaces out
+                # reconnects instead of retrying (and sleeping) under the lock.
+                reader, writer = await self._async_connect()
 
                 # Update connection statistics
-                if connection_success:
-                    self._last_successful_connection = time_lib.time()
-                    self._connection_failure_count = 0
-                    if connection_retry:
-                        self._connection_retry_count += 1
-                        _LOGGER.info("Successfully reconnected after %s attempts", retry)
+                if self._connection_failure_count:
+                    self._connection_retry_count += 1
+                    _LOGGER.info("Successfully reconnected after %s failed attempts", self._connection_failure_count)
+                self._last_successful_connection = time_lib.time()
+                self._connection_failure_count = 0
 
                 newly_polled_input_regs = {}
                 newly_polled_hold_regs = {}
                 newly_polled_battery_data = {}
 
                 await self._connection_manager.async_discard_initial_data(reader)
+                self._poll_scheduler.record_overhead(time_lib.monotonic() - cycle_start)
 
                 try:
+                    blocks = self._poll_scheduler.select(tiers)
+                    answered = {}  # tier -> every block of it returned registers
+                    fast_inputs = {}
+                    fast_read = None
+
                     # Poll INPUT registers (expecting function code 4)
-                    for reg in range(0, TOTAL_REGISTERS, self._block_size):
-                        reg_block = await self.async_request_registers(writer, reader, reg, "input", 4)
-                        if len(reg_block) > 0:
-                            newly_polled_input_regs.update(reg_block)
-
-                    # Poll battery data if enabled and inverter reports connected batteries
-                    # The decoding routine needs 120 registers for complete block processing
-                    if (self._request_battery_data
-                            and I_BAT_PARALLEL_NUM in newly_polled_input_regs
-                            and newly_polled_input_regs[I_BAT_PARALLEL_NUM] > 0
-                            and self._block_size >= 120):
-                        for reg in range(BATTERY_INFO_START_REGISTER,
-                                         BATTERY_INFO_START_REGISTER + 120,
-                                         self._block_size):
-                            bat_block = await self.async_request_registers(
-                                writer, reader, reg, "input/bat", 4)
-                            newly_polled_battery_data.update(bat_block)
+                    for block in blocks:
+                        if block.register_type != "input":
+                            continue
+                        reg_block = await self._async_request_block(writer, reader, block)
+                        answered[block.tier] = answered.get(block.tier, True) and bool(reg_block)
+                        fast = {register: value for register, value in reg_block.items()
+                                if self._poll_scheduler.is_fast_register(register)}
+                        if fast:
+                            fast_inputs.update(fast)
+                            fast_read = time_lib.monotonic()
+                        merge(newly_polled_input_regs, self._last_good_input_regs, reg_block)
 
                     # Poll HOLD registers (expecting function code 3)
-                    for reg in range(0, TOTAL_REGISTERS, self._block_size):
-                        reg_block = await self.async_request_registers(writer, reader, reg, "hold", 3)
-                        if len(reg_block) > 0:
-                            newly_polled_hold_regs.update(reg_block)
-
+                    for block in blocks:
+                        if block.register_type != "hold":
+                            continue
+                        reg_block = await self._async_request_block(writer, reader, block)
+                        self._confirm_hold_regs(reg_block)
+                        reg_block = self._reconcile_journal(reg_block)
+                        answered[block.tier] = answered.get(block.tier, True) and bool(reg_block)
+                        merge(newly_polled_hold_regs, self._last_good_hold_regs, reg_block)
+
+                    self._last_poll_live_tiers = frozenset(tier for tier, live in answered.items() if live)
+                    self._last_fast_tier_inputs = fast_inputs
+                    self._last_fast_tier_read = fast_read
                 except asyncio.TimeoutError:
                     _LOGGER.debug("Timeout requesting data from inverter")
+                else:
+                    # Poll battery data if enabled, last and on its own schedule so a slow BMS
+                    # cannot hold up the inverter registers. A live pack count of 0 reads no
+                    # page and reports every known pack as removed
+                    if ((tiers is None or TIER_SLOW in tiers)
+                            and self._request_battery_data
+                            and I_BAT_PARALLEL_NUM in newly_polled_input_regs):
+                        await self._async_poll_batteries(
+                            writer, reader, newly_polled_input_regs[I_BAT_PARALLEL_NUM],
+                            lambda bat_block: merge(newly_polled_battery_data, self._last_good_battery_data, bat_block))
 
                 # Close the connection
                 await self._connection_manager.async_close(writer)
+                cycle_duration = time_lib.monotonic() - cycle_start
+                self._poll_scheduler.record_cycle(cycle_duration)
+                self._latency[LATENCY_CYCLE].record(cycle_duration)
 
-            # Merge new data with the last known good data
-            if len(newly_polled_input_regs):
-                self._last_good_input_regs.update(newly_polled_input_regs)
-
-            if len(newly_polled_battery_data):
-                self._last_good_battery_data.update(newly_polled_battery_data)
-
-            if len(newly_polled_hold_regs):
-                self._last_good_hold_regs.update(newly_polled_hold_regs)
+            self._last_poll_live = bool(newly_polled_input_regs or newly_polled_hold_regs)
+            if self._data_is_stale and self._last_poll_live:
+                _LOGGER.debug("First live poll received, snapshot data is no longer stale")
+                self._data_is_stale = False
 
             # Always return a complete (though possibly stale) dataset
-            return {"input": self._last_good_input_regs, "hold": self._last_good_hold_regs, "battery": self._last_good_battery_data}
+            return data
 
         except Exception as ex:
             self._connection_failure_count += 1
+            if writer is not None and isinstance(ex, OSError):
+                # The connection dropped mid-poll; connect failures are already recorded
+                self._circuit_breaker.record_failure(ex)
             last_success_str = "never"
             if self._last_successful_connection:
                 elapsed_time = time_lib.time() - self._last_successful_connection
@@ -236,12 +557,16 @@ class LxpModbusApiClient:
                 minutes, seconds = divmod(remainder, 60)
                 last_success_str = f"{int(hours)}h {int(minutes)}m {int(seconds)}s ago"
 
-            _LOGGER.error("Total polling failure: %s. Consecutive failures: %s. Last success: %s",
-                          ex, self._connection_failure_count, last_success_str)
+            if isinstance(ex, CircuitOpenError):
+                _LOGGER.debug("Polling skipped: %s. Consecutive failures: %s. Last success: %s",
+                              ex, self._connection_failure_count, last_success_str)
+            else:
+                _LOGGER.error("Total polling failure: %s. Consecutive failures: %s. Last success: %s",
+                              ex, self._connection_failure_count, last_success_str)
 
             if self._last_good_input_regs and self._last_good_hold_regs and self._connection_failure_count <= MAX_CACHED_DATA_FAILURES:
                 _LOGGER.warning("Returning cached data due to temporary connection failure")
-                return {"input": self._last_good_input_regs, "hold": self._last_good_hold_regs, "battery": self._last_good_battery_data}
+                return self.cached_data
             else:
                 if self._connection_failure_count <= MAX_EMPTY_DATA_FAILURES:
                     _LOGGER.warning("No cached data available, returning empty data structure")
@@ -249,75 +574,423 @@ class LxpModbusApiClient:
                 else:
                     raise UpdateFailed(f"Error communicating with inverter: {ex}")
 
-    async def async_write_register(self, register: int, value: int) -> bool:
-        """Write a single register value to the inverter with validation and retries."""
+    def _confirm_hold_regs(self, regs: dict) -> None:
+        """Remember hold register values as read back from the inverter."""
+        now = time_lib.monotonic()
+        for register, value in regs.items():
+            self._confirmed_hold_regs[register] = (value, now)
+
+    def _reconcile_journal(self, regs: dict) -> dict:
+        """Confirm submitted writes a poll read back; return the block with the others still applied."""
+        for register, value in regs.items():
+            if self._write_journal.confirm(register, value, SOURCE_READ) and self.on_write_resolved:
+                self.on_write_resolved(register, value, None)
+        regs = dict(regs)
+        self._write_journal.overlay(regs)
+        return regs
+
+    def _record_confirmed_write(self, register: int, value: int) -> None:
+        self._last_good_hold_regs[register] = value
+        self._confirm_hold_regs({register: value})
+
+    def confirmed_value(self, register: int) -> int | None:
+        """Return the register value the inverter confirmed within WRITE_SKIP_MAX_AGE, else None."""
+        confirmed = self._confirmed_hold_regs.get(register)
+        if confirmed is None or time_lib.monotonic() - confirmed[1] > WRITE_SKIP_MAX_AGE:
+            return None
+        return confirmed[0]
+
+    async def async_write_register(self, register: int, value: int, force: bool = False) -> bool:
+        """Write a single register value to the inverter with validation and retries.
+
+        The write is skipped (and reported as successful) when the inverter recently
+        confirmed this exact value, unless force is set.
+        """
+        if not force and self.confirmed_value(register) == value:
+            self._skipped_writes += 1
+            _LOGGER.debug("Skipping write of %s to register %s: value already confirmed", value, register)
+            return True
+        return await self._async_write_with_retries(register, value) is not None
+
+    async def async_write_bits(self, register: int, mask: int, bits: int, force: bool = False,
+                               window: float | None = None) -> int | None:
+        """Change only the masked bits of a hold register.
+
+        Changes to the same register arriving within RMW_BATCH_WINDOW are merged.
+        The current value is read on the write session itself, so bits changed
+        by the inverter or another caller since the last poll are preserved.
+        Returns the confirmed register value, or None if the write failed.
+        Like async_write_register, a change the inverter already reflects is skipped unless forced.
+        window overrides the batch window (see async_write_debounced).
+        """
+        confirmed = None if force else self.confirmed_value(register)
+        # A change still queued or in flight may be about to alter these bits
+        if confirmed is not None and (confirmed ^ bits) & mask == 0 and not self._bit_writer.is_busy(register):
+            self._skipped_writes += 1
+            _LOGGER.debug("Skipping bit change 0x%04x of register %s: bits already confirmed", mask, register)
+            return confirmed
+        return await self._bit_writer.async_write_bits(register, mask, bits, window=window)
+
+    async def async_write_debounced(self, register: int, mask: int, bits: int) -> int | None:
+        """Write a value that may be superseded shortly, e.g. from a number entity.
+
+        Successive writes to the register within the write debounce window are
+        coalesced: only the latest target is written and every caller receives
+        the result of that write. Returns the confirmed register value or None.
+        """
+        return await self.async_write_bits(register, mask, bits, window=self._write_debounce)
+
+    def submit_write(self, register: int, mask: int, bits: int, debounce: bool = False) -> int:
+        """Acknowledge a bit change immediately and write it in the background.
+
+        The optimistic register value is returned and kept in the cached data,
+        also across polls that still read the old value, until the write
+        acknowledgement or a poll confirms it. If the write fails the register
+        reverts to the value last read from the inverter. on_write_resolved is
+        called either way. debounce coalesces values like async_write_debounced.
+        """
+        current = self._last_good_hold_regs.get(register, 0)
+        optimistic = self._write_journal.add(register, mask, bits, current)
+        self._last_good_hold_regs[register] = optimistic
+
+        task = asyncio.ensure_future(self._async_complete_write(
+            register, mask, bits, debounce, self._write_journal.last_sequence))
+        self._write_tasks.add(task)
+        task.add_done_callback(self._write_tasks.discard)
+        return optimistic
+
+    async def _async_complete_write(self, register: int, mask: int, bits: int, debounce: bool,
+                                    sequence: int) -> None:
+        """Write a submitted change and resolve its journal entry."""
+        try:
+            confirmed = await self.async_write_bits(
+                register, mask, bits, window=self._write_debounce if debounce else None)
+        except Exception as ex:
+            _LOGGER.error("Background write of register %s failed: %s", register, ex)
+            confirmed = None
+
+        if confirmed is not None:
+            resolved = self._write_journal.confirm(register, confirmed, SOURCE_ACK)
+            # Later submissions to the register may still be pending
+            self._write_journal.overlay(self._last_good_hold_regs)
+            if resolved and self.on_write_resolved:
+                self.on_write_resolved(register, confirmed, None)
+            return
+
+        entry = self._write_journal.fail(register, sequence)
+        if entry is None:
+            # Already confirmed by a poll, reverted with an earlier failed write,
+            # or every bit was changed again by a write still queued
+            return
+        last_read = self._confirmed_hold_regs.get(register)
+        last_read = last_read[0] if last_read is not None else entry.previous
+        if self._write_journal.pending(register) is None:
+            attempted = entry.apply(entry.previous)
+            restored = last_read
+        else:
+            # Only this write's bits revert; those of later writes stay shown
+            attempted = self._last_good_hold_regs.get(register, entry.previous)
+            restored = (attempted & ~entry.mask) | (last_read & entry.mask)
+        self._last_good_hold_regs[register] = restored
+        _LOGGER.warning("Write of %s to register %s was not confirmed, reverted to %s",
+                        attempted, register, restored)
+        if self.on_write_resolved:
+            self.on_write_resolved(register, attempted, restored)
+
+    async def async_wait_for_writes(self) -> None:
+        """Wait until every submitted write has been written or reverted."""
+        if self._write_tasks:
+            await asyncio.gather(*self._write_tasks, return_exceptions=True)
+
+    async def _async_write_masked(self, register: int, mask: int, bits: int) -> int | None:
+        """Write a merged bit change, reading the register first unless every bit is set."""
+        if mask == REGISTER_MASK:
+            return await self._async_write_with_retries(register, bits & REGISTER_MASK)
+        return await self._async_write_with_retries(register, lambda current: (current & ~mask) | (bits & mask))
+
+    async def _async_write_with_retries(self, register: int, value) -> int | None:
+        """Write a value (or a function of the current value) with retries. Returns the confirmed value."""
         for attempt in range(self._connection_retries):
-            writer = None
+            if self._circuit_breaker.state == STATE_OPEN:
+                _LOGGER.warning("Write to register %s rejected: dongle circuit is open, next attempt in %.0fs",
+                                register, self._circuit_breaker.retry_in)
+                return None
 
-            try:
-                async with self._lock:
-                    _LOGGER.debug("Write attempt %s/%s for register %s with value %s",
-                                  attempt + 1, self._connection_retries, register, value)
-
-                    try:
-                        reader, writer = await self._connection_manager.async_connect()
-                    except (asyncio.TimeoutError, ConnectionRefusedError, OSError) as e:
-                        _LOGGER.warning("Connection attempt failed during write: %s", e)
-                        await asyncio.sleep(WRITE_RETRY_DELAY)
-                        continue
-
-                    await self._connection_manager.async_discard_initial_data(reader)
-
-                    req = LxpRequestBuilder.prepare_packet_for_write(
-                        self._dongle_serial.encode(), self._inverter_serial.encode(), register, value
-                    )
-                    writer.write(req)
-                    await writer.drain()
-
-                    response_buf = await reader.read(WRITE_RESPONSE_LENGTH)
-
-                    _LOGGER.debug(
-                        "Modbus WRITE: Sent to reg %s, value %s, resp: %s",
-                        register, value, response_buf.hex() if response_buf else "None"
-                    )
-
-                    # Close the connection
-                    await self._connection_manager.async_close(writer)
-                    writer = None  # Mark as closed to prevent double-close in exception handler
-
-                    # --- Response Validation ---
-                    if not response_buf:
-                        _LOGGER.warning("Write attempt %d failed: Response not received", attempt + 1)
-                        await asyncio.sleep(WRITE_RETRY_DELAY)
-                        continue
-
-                    response = LxpResponse(response_buf)
-                    if response.packet_error:
-                        _LOGGER.warning("Write attempt %s failed: Inverter returned a packet error. %s",
-                                        attempt + 1, response.info)
-                        await asyncio.sleep(WRITE_RETRY_DELAY)
-                        continue
-
-                    response_dict = response.parsed_values_dictionary
-                    if register in response_dict:
-                        received_value = response_dict.get(register)
-                        if received_value == value:
-                            _LOGGER.info("Successfully wrote register %s with value %s.", register, value)
-                            return True
-
-                        _LOGGER.warning("Write attempt %s failed: Confirmation mismatch, sent=%s received=%s",
-                                        attempt + 1, value, received_value)
-                    else:
-                        _LOGGER.warning("Write attempt %s failed: Confirmation mismatch, written register %s not received on confirmation. %s",
-                                        attempt + 1, register, response.info)
-
-                    await asyncio.sleep(WRITE_RETRY_DELAY)
+            confirmed = await self._async_write_attempt(register, value, attempt)
+            if confirmed is not None:
+                return confirmed
 
-            except Exception as ex:
-                _LOGGER.error("Exception during write attempt %d for register %s: %s", attempt + 1, register, ex)
-                if writer:
-                    await self._connection_manager.async_close(writer)
+            # Back off outside the lock so polls and other writes are not blocked
+            if attempt < self._connection_retries - 1:
                 await asyncio.sleep(WRITE_RETRY_DELAY)
 
         _LOGGER.error("Failed to write register %s after %d attempts.", register, self._connection_retries)
-        return False
+        return None
+
+    async def _async_write_attempt(self, register: int, value, attempt: int) -> int | None:
+        """Perform one locked connect/write/confirm cycle.
+
+        value is either the register value or a function computing it from the
+        current value, which is then read on the same session first. Returns the
+        value confirmed by the inverter, or None.
+        """
+        writer = None
+
+        try:
+            async with self._session(PRIORITY_WRITE):
+                try:
+                    reader, writer = await self._async_connect()
+                except (asyncio.TimeoutError, ConnectionRefusedError, OSError, CircuitOpenError) as e:
+                    _LOGGER.warning("Connection attempt failed during write: %s", e)
+                    return None
+
+                await self._connection_manager.async_discard_initial_data(reader)
+
+                if callable(value):
+                    current = (await self.async_request_registers(
+                        writer, reader, register, "hold", HOLD_FUNCTION_CODE, 1)).get(register)
+                    if current is None:
+                        _LOGGER.warning("Write attempt %d failed: could not read current value of register %s",
+                                        attempt + 1, register)
+                        await self._connection_manager.async_close(writer)
+                        return None
+                    self._confirm_hold_regs({register: current})
+                    new_value = value(current)
+                    if new_value == current:
+                        _LOGGER.debug("Register %s already has value %s, nothing to write", register, current)
+                        await self._connection_manager.async_close(writer)
+                        self._last_good_hold_regs[register] = current
+                        return current
+                else:
+                    new_value = value
+
+                _LOGGER.debug("Write attempt %s/%s for register %s with value %s",
+                              attempt + 1, self._connection_retries, register, new_value)
+
+                req = LxpRequestBuilder.prepare_packet_for_write(
+                    self._dongle_serial.encode(), self._inverter_serial.encode(), register, new_value
+                )
+                sent = time_lib.monotonic()
+                self._frame_trace.record(DIRECTION_TX, req)
+                writer.write(req)
+                await writer.drain()
+
+                response_buf = await reader.read(WRITE_RESPONSE_LENGTH)
+                self._frame_trace.record(DIRECTION_RX, response_buf)
+                if response_buf:
+                    self._latency[LATENCY_WRITE].record(time_lib.monotonic() - sent)
+
+                _LOGGER.debug(
+                    "Modbus WRITE: Sent to reg %s, value %s, resp[%d]",
+                    register, new_value, len(response_buf) if response_buf else 0
+                )
+
+                # Close the connection
+                await self._connection_manager.async_close(writer)
+                writer = None  # Mark as closed to prevent double-close in exception handler
+
+            # --- Response Validation ---
+            if not response_buf:
+                _LOGGER.warning("Write attempt %d failed: Response not received", attempt + 1)
+                self._circuit_breaker.record_failure("no write response")
+                return None
+
+            response = LxpResponse(response_buf)
+            if response.packet_error:
+                _LOGGER.warning("Write attempt %s failed: Inverter returned a packet error. %s",
+                                attempt + 1, response.info)
+                return None
+
+            response_dict = response.parsed_values_dictionary
+            if register in response_dict:
+                received_value = response_dict.get(register)
+                if received_value == new_value:
+                    _LOGGER.info("Successfully wrote register %s with value %s.", register, new_value)
+                    self._record_confirmed_write(register, new_value)
+                    return new_value
+
+                _LOGGER.warning("Write attempt %s failed: Confirmation mismatch, sent=%s received=%s",
+                                attempt + 1, new_value, received_value)
+            else:
+                _LOGGER.warning("Write attempt %s failed: Confirmation mismatch, written register %s not received on confirmation. %s",
+                                attempt + 1, register, response.info)
+            return None
+
+        except Exception as ex:
+            _LOGGER.error("Exception during write attempt %d for register %s: %s", attempt + 1, register, ex)
+            if writer:
+                await self._connection_manager.async_close(writer)
+            return None
+
+    async def async_write_registers(self, values: dict[int, int], masks: dict[int, int] | None = None) -> dict:
+        """Apply a set of hold register values as one transaction on a single session.
+
+        The target registers are read first and only those that differ are
+        written, contiguous ones together in write-multiple frames (unchanged
+        targets between two changes are rewritten to avoid a split). Everything
+        written is read back; if any write or verification fails or times out,
+        every changed register is restored to the value it had before the transaction.
+        For registers listed in masks only the masked bits are set from values.
+
+        Returns a result dict: success, changed (registers now holding their
+        target), unchanged, failed, rolled_back and previous (the values the
+        changed registers had before).
+        """
+        targets = {int(register): int(value) & REGISTER_MASK for register, value in values.items()}
+        result = {"success": False, "changed": [], "unchanged": [], "failed": [], "rolled_back": False,
+                  "previous": {}}
+        if not targets:
+            result["success"] = True
+            return result
+
+        if self._circuit_breaker.state == STATE_OPEN:
+            _LOGGER.warning("Register transaction rejected: dongle circuit is open, next attempt in %.0fs",
+                            self._circuit_breaker.retry_in)
+            result["failed"] = sorted(targets)
+            return result
+
+        async with self._session(PRIORITY_WRITE):
+            try:
+                reader, writer = await self._async_connect()
+            except (asyncio.TimeoutError, ConnectionRefusedError, OSError, CircuitOpenError) as e:
+                _LOGGER.warning("Connection attempt failed during register transaction: %s", e)
+                result["failed"] = sorted(targets)
+                return result
+
+            try:
+                await self._connection_manager.async_discard_initial_data(reader)
+                await self._async_run_transaction(writer, reader, targets, masks or {}, result)
+            except Exception as ex:
+                _LOGGER.error("Exception during register transaction: %s", ex)
+                result["success"] = False
+                result["failed"] = sorted(set(targets) - set(result["unchanged"]))
+            finally:
+                await self._connection_manager.async_close(writer)
+        return result
+
+    async def _async_run_transaction(self, writer, reader, targets: dict[int, int], masks: dict[int, int],
+                                     result: dict) -> None:
+        """Diff, write, verify and if needed roll back on an open session, filling in result."""
+        # Diff against the inverter's current values, which are also the rollback state
+        original = await self._async_read_hold_registers(writer, reader, targets)
+        if len(original) != len(targets):
+            _LOGGER.warning("Register transaction aborted: could not read registers %s",
+                            sorted(set(targets) - set(original)))
+            result["failed"] = sorted(targets)
+            return
+        self._confirm_hold_regs(original)
+
+        for register, mask in masks.items():
+            if register in targets:
+                targets[register] = (original[register] & ~mask) | (targets[register] & mask)
+        changes = {register: value for register, value in targets.items() if original[register] != value}
+        result["unchanged"] = sorted(set(targets) - set(changes))
+        result["previous"] = {register: original[register] for register in changes}
+
+        # Unchanged targets between two changes are rewritten with their current value,
+        # so each stretch of the request goes out as one frame instead of several
+        changed_registers = sorted(changes)
+        to_write = dict(changes)
+        for previous, following in zip(changed_registers, changed_registers[1:]):
+            gap = range(previous + 1, following)
+            if all(register in targets for register in gap):
+                to_write.update({register: original[register] for register in gap})
+
+        try:
+            failed = await self._async_write_and_verify(writer, reader, to_write)
+        except Exception as ex:
+            # A run may have been applied even though its acknowledgement never arrived
+            _LOGGER.error("Exception during register transaction: %s", ex)
+            failed = sorted(to_write)
+        if not failed:
+            result["success"] = True
+            result["changed"] = sorted(changes)
+            for register, value in changes.items():
+                self._record_confirmed_write(register, value)
+            return
+
+        # Partial failure: restore every register the transaction may have touched
+        _LOGGER.warning("Register transaction failed for %s, rolling back %s registers", failed, len(to_write))
+        result["failed"] = failed
+        rollback = {register: original[register] for register in to_write}
+        try:
+            rollback_failed = await self._async_write_and_verify(writer, reader, rollback)
+        except Exception as ex:
+            _LOGGER.error("Exception during register transaction rollback: %s", ex)
+            rollback_failed = sorted(rollback)
+        result["rolled_back"] = not rollback_failed
+        if rollback_failed:
+            _LOGGER.error("Rollback failed for registers %s", rollback_failed)
+        for register, value in rollback.items():
+            if register not in rollback_failed:
+                self._record_confirmed_write(register, value)
+
+    async def _async_read_hold_registers(self, writer, reader, registers) -> dict:
+        """Read the given hold registers on an open session, one request per contiguous run."""
+        values = {}
+        for start, count in contiguous_runs(registers, MULTI_WRITE_MAX_REGISTERS):
+            block = await self.async_request_registers(writer, reader, start, "hold", HOLD_FUNCTION_CODE, count)
+            values.update({register: block[register] for register in range(start, start + count) if register in block})
+        return values
+
+    async def _async_write_and_verify(self, writer, reader, values: dict[int, int]) -> list[int]:
+        """Write register values in contiguous runs and read them back. Returns the registers that failed."""
+        failed = []
+        for start, count in contiguous_runs(values, MULTI_WRITE_MAX_REGISTERS):
+            run = [values[register] for register in range(start, start + count)]
+            if not await self._async_write_run(writer, reader, start, run):
+                failed.extend(range(start, start + count))
+        written = {register: value for register, value in values.items() if register not in failed}
+        confirmed = await self._async_read_hold_registers(writer, reader, written)
+        failed.extend(register for register, value in written.items() if confirmed.get(register) != value)
+        return sorted(failed)
+
+    async def _async_write_run(self, writer, reader, start: int, run: list[int]) -> bool:
+        """Send one run of consecutive register values and check the inverter's acknowledgement."""
+        if len(run) == 1:
+            req = LxpRequestBuilder.prepare_packet_for_write(
+                self._dongle_serial.encode(), self._inverter_serial.encode(), start, run[0])
+            function_code = LxpRequestBuilder.WRITE_SINGLE
+        else:
+            req = LxpRequestBuilder.prepare_packet_for_write_multi(
+                self._dongle_serial.encode(), self._inverter_serial.encode(), start, run)
+            function_code = LxpRequestBuilder.WRITE_MULTI
+        sent = time_lib.monotonic()
+        self._frame_trace.record(DIRECTION_TX, req)
+        writer.write(req)
+        await writer.drain()
+        response_buf = await asyncio.wait_for(reader.read(WRITE_RESPONSE_LENGTH), timeout=READ_TIMEOUT)
+        self._frame_trace.record(DIRECTION_RX, response_buf)
+        if response_buf:
+            self._latency[LATENCY_WRITE].record(time_lib.monotonic() - sent)
+
+        _LOGGER.debug("Modbus WRITE(%s): Sent regs %s-%s, values %s, resp[%d]",
+                      function_code, start, start + len(run) - 1, run,
+                      len(response_buf) if response_buf else 0)
+
+        if not response_buf:
+            _LOGGER.warning("Write of registers %s-%s failed: Response not received", start, start + len(run) - 1)
+            return False
+        response = LxpResponse(response_buf)
+        if response.packet_error or response.device_function != function_code or response.register != start:
+            _LOGGER.warning("Write of registers %s-%s failed: %s", start, start + len(run) - 1, response.info)
+            return False
+        return True
+
+    def get_diagnostics(self) -> dict:
+        """Return runtime state of the client for diagnostic entities."""
+        return {
+            "circuit_breaker": self._circuit_breaker.as_dict(),
+            "consecutive_poll_failures": self._connection_failure_count,
+            "reconnections": self._connection_retry_count,
+            "last_successful_connection": self._last_successful_connection,
+            "packet_recovery": self._packet_recovery.get_stats(),
+            "poll_scheduler": self._poll_scheduler.get_stats(),
+            "bitfield_writes": self._bit_writer.get_stats(),
+            "skipped_writes": self._skipped_writes,
+            "write_journal": self._write_journal.get_stats(),
+            "routed_frames": self._routed_frames,
+            "io_scheduler": self._io_scheduler.get_stats(),
+            "batteries": self._battery_schedule.get_stats(),
+            "latency": {name: histogram.get_stats() for name, histogram in self._latency.items()},
+        }
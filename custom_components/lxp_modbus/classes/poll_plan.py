@@ -0,0 +1,62 @@
+"""Register block layout used to plan each polling cycle."""
+from dataclasses import dataclass
+
+from ..const import (
+    BATTERY_BLOCK_REGISTERS,
+    BATTERY_INFO_START_REGISTER,
+    BATTERY_MAX_PACKS,
+    FAST_TIER_INPUT_END,
+    TIER_FAST,
+    TIER_SLOW,
+    TOTAL_REGISTERS,
+)
+
+INPUT_FUNCTION_CODE = 4
+HOLD_FUNCTION_CODE = 3
+
+
+@dataclass(frozen=True)
+class RegisterBlock:
+    """A single block read issued during a polling cycle."""
+
+    register_type: str
+    function_code: int
+    start: int
+    count: int
+    tier: str
+
+
+def build_poll_plan(block_size: int) -> list[RegisterBlock]:
+    """Split the input and hold register ranges into blocks of block_size.
+
+    Input blocks come first, then hold blocks, matching the order the inverter
+    has always been polled in. Battery blocks are not part of the static plan
+    because their number depends on the live battery count.
+    """
+    plan = []
+    for register_type, function_code in (("input", INPUT_FUNCTION_CODE), ("hold", HOLD_FUNCTION_CODE)):
+        for start in range(0, TOTAL_REGISTERS, block_size):
+            tier = TIER_FAST if register_type == "input" and start < FAST_TIER_INPUT_END else TIER_SLOW
+            plan.append(RegisterBlock(
+                register_type, function_code, start, min(block_size, TOTAL_REGISTERS - start), tier
+            ))
+    return plan
+
+
+def build_battery_pages(block_size: int, pack_count: int) -> list[RegisterBlock]:
+    """Split the battery range of pack_count packs into reads of whole 30-register packs.
+
+    Each read covers as many packs as fit into block_size (at least one, so
+    legacy firmware limited to 40-register blocks reads one pack per request)
+    and starts on a pack boundary, which lets every response be decoded on its own.
+    """
+    pack_count = max(0, min(pack_count, BATTERY_MAX_PACKS))
+    packs_per_read = max(1, block_size // BATTERY_BLOCK_REGISTERS)
+    pages = []
+    for first in range(0, pack_count, packs_per_read):
+        packs = min(packs_per_read, pack_count - first)
+        pages.append(RegisterBlock(
+            "battery", INPUT_FUNCTION_CODE, BATTERY_INFO_START_REGISTER + first * BATTERY_BLOCK_REGISTERS,
+            packs * BATTERY_BLOCK_REGISTERS, TIER_SLOW
+        ))
+    return pages
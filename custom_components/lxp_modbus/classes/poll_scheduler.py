@@ -0,0 +1,199 @@
+"""Per-cycle selection of register blocks under a time budget."""
+import logging
+
+from ..const import (
+    POLL_BLOCK_RTT_ESTIMATE,
+    POLL_RTT_SMOOTHING,
+    ROTATION_MAX_LAG_CYCLES,
+    TIER_FAST,
+)
+from .poll_plan import INPUT_FUNCTION_CODE, RegisterBlock
+
+_LOGGER = logging.getLogger(__name__)
+
+
+class PollScheduler:
+    """Chooses which blocks of the poll plan to read in each cycle.
+
+    Fast-tier (high-priority) blocks are always read. The remaining blocks are
+    rotated round-robin, stalest first, until the next one's estimated read
+    time no longer fits into the cycle budget. A block that has not been refreshed for
+    max_lag_cycles cycles is read regardless of the budget, so every block is
+    refreshed at least every max_lag_cycles cycles.
+
+    Only full polls (all tiers) count as rotation cycles: a fast-only poll
+    (burst polling, the export controller) cannot read slow blocks and so
+    does not age them.
+
+    Input registers outside the fast blocks can be pinned to the fast tier by
+    consumers that need them fresh on every poll (the export controller, parallel
+    groups). They are read in an extra fast block per slow block holding them,
+    right after the fast blocks, unless that slow block is read in the cycle anyway.
+
+    Read times are learned per block as an exponentially weighted average,
+    together with the per-cycle session overhead (connect and initial discard).
+    Without a budget every selected block is read on every cycle.
+    """
+
+    def __init__(self, plan: list[RegisterBlock], budget: float | None = None,
+                 max_lag_cycles: int = ROTATION_MAX_LAG_CYCLES):
+        """Initialize the scheduler for a compiled poll plan."""
+        self._plan = plan
+        self._order = {block: index for index, block in enumerate(plan)}
+        self._budget = budget
+        self._max_lag_cycles = max(1, max_lag_cycles)
+        self._cycle = 0
+        self._last_polled = {}
+        self._rtt = {}
+        self._overhead = 0.0
+        self._pinned = {}  # consumer key -> input registers pinned to the fast tier
+        self._pinned_blocks = []
+        self._fast_ranges = [range(block.start, block.start + block.count) for block in plan
+                             if block.tier == TIER_FAST and block.register_type == "input"]
+        fast_indexes = [index for index, block in enumerate(plan) if block.tier == TIER_FAST]
+        self._pinned_position = max(fast_indexes, default=-1)
+
+        self._overruns = 0
+        self._last_cycle_duration = None
+        self._deferred_last_cycle = 0
+
+    @property
+    def plan(self) -> list[RegisterBlock]:
+        return self._plan
+
+    @property
+    def budget(self) -> float | None:
+        return self._budget
+
+    @budget.setter
+    def budget(self, value: float | None) -> None:
+        self._budget = value
+
+    @property
+    def pinned(self) -> dict[str, frozenset]:
+        return dict(self._pinned)
+
+    def pin(self, key: str, registers) -> None:
+        """Read the input registers on the fast tier for consumer key, replacing its earlier pins."""
+        registers = frozenset(registers)
+        if self._pinned.get(key) == registers:
+            return
+        self._pinned[key] = registers
+        self._build_pinned_blocks()
+
+    def unpin(self, key: str) -> None:
+        """Drop the fast-tier pins of consumer key."""
+        if self._pinned.pop(key, None) is not None:
+            self._build_pinned_blocks()
+
+    def is_fast_register(self, register: int) -> bool:
+        """Return True if the input register is read on the fast tier, in a fast block or pinned."""
+        return self._in_fast_block(register) or any(register in registers for registers in self._pinned.values())
+
+    def _in_fast_block(self, register: int) -> bool:
+        return any(register in fast for fast in self._fast_ranges)
+
+    def _build_pinned_blocks(self) -> None:
+        """Cover the pinned registers outside the fast blocks with one block per holding slow block."""
+        spans = {}
+        for register in set().union(*self._pinned.values()):
+            if self._in_fast_block(register):
+                continue
+            holder = self._covering_block(register)
+            if holder is None:
+                continue
+            low, high = spans.get(holder, (register, register))
+            spans[holder] = (min(low, register), max(high, register))
+        self._pinned_blocks = [
+            RegisterBlock("input", INPUT_FUNCTION_CODE, low, high - low + 1, TIER_FAST)
+            for low, high in sorted(spans.values())
+        ]
+
+    def _covering_block(self, register: int) -> RegisterBlock | None:
+        return next((block for block in self._plan if block.register_type == "input"
+                     and block.start <= register < block.start + block.count), None)
+
+    def _position(self, block: RegisterBlock) -> tuple:
+        if block in self._order:
+            return (self._order[block], 0)
+        return (self._pinned_position, 1)
+
+    def estimate(self, block: RegisterBlock) -> float:
+        """Return the expected read time of a block in seconds."""
+        return self._rtt.get(block, POLL_BLOCK_RTT_ESTIMATE)
+
+    def lag(self, block: RegisterBlock) -> int:
+        """Return the number of cycles since the block was last refreshed."""
+        return self._cycle - self._last_polled.get(block, 0)
+
+    def select(self, tiers=None) -> list[RegisterBlock]:
+        """Return the blocks to read, in plan order; a full poll (tiers None) starts a new rotation cycle."""
+        if tiers is None:
+            self._cycle += 1
+        candidates = [block for block in self._plan if tiers is None or block.tier in tiers]
+
+        pinned = self._pinned_blocks if tiers is None or TIER_FAST in tiers else []
+
+        if self._budget is None:
+            self._deferred_last_cycle = 0
+            return self._with_pinned(candidates, pinned)
+
+        selected = [block for block in candidates if block.tier == TIER_FAST]
+        spent = self._overhead + sum(self.estimate(block) for block in selected + pinned)
+
+        # Stalest first; never-polled blocks sort before everything else
+        rotating = sorted((block for block in candidates if block.tier != TIER_FAST),
+                          key=lambda block: (self._last_polled.get(block, 0), self._order[block]))
+        deferred = 0
+        for block in rotating:
+            cost = self.estimate(block)
+            # Once a block misses the budget the rotation stops there, so a cheap but
+            # recently read block cannot jump ahead of a staler one
+            if (not deferred and spent + cost <= self._budget) or self.lag(block) >= self._max_lag_cycles:
+                selected.append(block)
+                spent += cost
+            else:
+                deferred += 1
+
+        self._deferred_last_cycle = deferred
+        if deferred:
+            _LOGGER.debug("Poll cycle %s: reading %s blocks, deferring %s to stay within %.1fs budget",
+                          self._cycle, len(selected), deferred, self._budget)
+
+        return self._with_pinned(selected, pinned)
+
+    def _with_pinned(self, selected: list[RegisterBlock], pinned: list[RegisterBlock]) -> list[RegisterBlock]:
+        """Add the pinned blocks whose slow block is not read anyway and order the cycle's reads."""
+        extra = [block for block in pinned if self._covering_block(block.start) not in selected]
+        return sorted(selected + extra, key=self._position)
+
+    def record_block(self, block: RegisterBlock, duration: float, success: bool) -> None:
+        """Record the outcome of one block read in the current cycle."""
+        previous = self._rtt.get(block)
+        self._rtt[block] = duration if previous is None else (
+            previous + POLL_RTT_SMOOTHING * (duration - previous))
+        if success:
+            self._last_polled[block] = self._cycle
+
+    def record_overhead(self, duration: float) -> None:
+        """Record the session setup time (connect and initial discard) of the current cycle."""
+        self._overhead += POLL_RTT_SMOOTHING * (duration - self._overhead) if self._overhead else duration
+
+    def record_cycle(self, duration: float) -> None:
+        """Record the total duration of the current cycle."""
+        self._last_cycle_duration = duration
+        if self._budget is not None and duration > self._budget:
+            self._overruns += 1
+            _LOGGER.debug("Poll cycle %s overran its budget: %.1fs > %.1fs", self._cycle, duration, self._budget)
+
+    def get_stats(self) -> dict:
+        """Return scheduling metrics for diagnostics."""
+        return {
+            "budget": self._budget,
+            "cycles": self._cycle,
+            "last_cycle_duration": round(self._last_cycle_duration, 2) if self._last_cycle_duration is not None else None,
+            "overruns": self._overruns,
+            "deferred_blocks_last_cycle": self._deferred_last_cycle,
+            "max_rotation_lag": max((self.lag(block) for block in self._plan if block.tier != TIER_FAST), default=0),
+            "pinned_fast_registers": sorted(set().union(*self._pinned.values())),
+        }
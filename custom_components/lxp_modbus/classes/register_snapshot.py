@@ -0,0 +1,83 @@
+"""Persistence of the last good register snapshot across restarts."""
+import logging
+import time as time_lib
+
+from homeassistant.core import HomeAssistant
+from homeassistant.helpers.storage import Store
+
+from ..const import DOMAIN, SNAPSHOT_SAVE_DELAY, SNAPSHOT_STORAGE_VERSION
+
+_LOGGER = logging.getLogger(__name__)
+
+
+class RegisterSnapshotStore:
+    """Stores the last good input/hold/battery data of one config entry.
+
+    Writes are throttled: after a poll at most one write is scheduled per
+    SNAPSHOT_SAVE_DELAY, and it serializes whatever data is current when it
+    runs. Home Assistant flushes a pending write on shutdown.
+    """
+
+    def __init__(self, hass: HomeAssistant, entry_id: str):
+        """Initialize the store for a config entry."""
+        self._store = Store(hass, SNAPSHOT_STORAGE_VERSION, f"{DOMAIN}.{entry_id}.snapshot")
+        self._data = None
+        self._save_pending = False
+
+    @staticmethod
+    def _serialize(data: dict) -> dict:
+        return {
+            "saved_at": time_lib.time(),
+            "input": {str(reg): value for reg, value in data.get("input", {}).items()},
+            "hold": {str(reg): value for reg, value in data.get("hold", {}).items()},
+            "battery": dict(data.get("battery", {})),
+        }
+
+    @staticmethod
+    def _deserialize(stored: dict) -> dict:
+        # JSON turns register numbers (and battery block offsets) into strings
+        return {
+            "input": {int(reg): value for reg, value in stored["input"].items()},
+            "hold": {int(reg): value for reg, value in stored["hold"].items()},
+            "battery": {
+                serial: {key if key == "serial" else int(key): value for key, value in pack.items()}
+                for serial, pack in stored.get("battery", {}).items()
+            },
+        }
+
+    async def async_load(self) -> dict | None:
+        """Return the stored snapshot, or None if there is no usable one."""
+        stored = await self._store.async_load()
+        if not stored:
+            return None
+        try:
+            snapshot = self._deserialize(stored)
+        except (KeyError, TypeError, ValueError, AttributeError) as e:
+            _LOGGER.warning("Ignoring unreadable register snapshot: %s", e)
+            return None
+        if not snapshot["input"] or not snapshot["hold"]:
+            return None
+        _LOGGER.debug("Loaded register snapshot saved %.0fs ago",
+                      time_lib.time() - stored.get("saved_at", time_lib.time()))
+        return snapshot
+
+    def _data_to_save(self) -> dict:
+        self._save_pending = False
+        return self._serialize(self._data)
+
+    def async_schedule_save(self, data: dict) -> None:
+        """Schedule a delayed write of the data unless one is already pending."""
+        self._data = data
+        if self._save_pending:
+            return
+        self._save_pending = True
+        self._store.async_delay_save(self._data_to_save, SNAPSHOT_SAVE_DELAY)
+
+    async def async_save(self, data: dict) -> None:
+        """Write the data immediately, e.g. when the entry is unloaded."""
+        self._data = data
+        await self._store.async_save(self._data_to_save())
+
+    async def async_remove(self) -> None:
+        """Delete the stored snapshot."""
+        await self._store.async_remove()
@@ -0,0 +1,137 @@
+"""Journal of hold register writes acknowledged before the inverter confirmed them."""
+import logging
+import time as time_lib
+
+from .bitfield_writer import REGISTER_MASK
+
+_LOGGER = logging.getLogger(__name__)
+
+SOURCE_ACK = "ack"
+SOURCE_READ = "read"
+
+
+class PendingWrite:
+    """Bits of one register that were acknowledged optimistically and await confirmation."""
+
+    def __init__(self, register: int, previous: int):
+        self.register = register
+        self.previous = previous
+        self.mask = 0
+        self.bits = 0
+        self.created = time_lib.monotonic()
+        self._owners = {}  # submission sequence -> pending bits whose latest value it wrote
+
+    def add(self, mask: int, bits: int, sequence: int = 0) -> None:
+        # A later change of the same bit wins
+        self.bits = (self.bits & ~mask) | (bits & mask)
+        self.mask |= mask
+        for owner in list(self._owners):
+            self._owners[owner] &= ~mask
+            if not self._owners[owner]:
+                del self._owners[owner]
+        self._owners[sequence] = mask
+
+    def release(self, sequence: int) -> "PendingWrite | None":
+        """Remove the bits a submission still owns and return them as an entry of their own.
+
+        Returns self if the submission owns every pending bit, None if later
+        submissions changed all of its bits again.
+        """
+        mask = self._owners.pop(sequence, 0)
+        if not mask:
+            return None
+        if not self._owners:
+            return self
+        released = PendingWrite(self.register, self.previous)
+        released.mask = mask
+        released.bits = self.bits & mask
+        self.mask &= ~mask
+        self.bits &= ~mask
+        return released
+
+    def apply(self, value: int) -> int:
+        """Return value with the pending bits applied."""
+        return (value & ~self.mask) | self.bits
+
+    def matches(self, value: int) -> bool:
+        return (value ^ self.bits) & self.mask == 0
+
+
+class WriteJournal:
+    """Optimistic overlay for writes that are still being confirmed.
+
+    Each register with unconfirmed writes has one entry collecting the written
+    bits. The entry is confirmed when a write acknowledgement or a poll reads the
+    register with those bits; until then polls that still return the old value
+    do not overwrite the overlay. If a write fails, the bits whose latest value
+    it carried are removed and the caller reverts them to the value last read
+    from the inverter; bits of later submissions still queued stay pending.
+    """
+
+    def __init__(self):
+        """Initialize an empty journal."""
+        self._pending = {}
+        self._sequence = 0
+        self._confirmed = {SOURCE_ACK: 0, SOURCE_READ: 0}
+        self._reverted = 0
+
+    @property
+    def last_sequence(self) -> int:
+        """Return the sequence number of the latest submission, for fail()."""
+        return self._sequence
+
+    def add(self, register: int, mask: int, bits: int, current: int) -> int:
+        """Record a write of the masked bits and return the register's optimistic value."""
+        entry = self._pending.get(register)
+        if entry is None:
+            entry = self._pending[register] = PendingWrite(register, current)
+        self._sequence += 1
+        entry.add(mask & REGISTER_MASK, bits, self._sequence)
+        return entry.apply(current)
+
+    def pending(self, register: int) -> PendingWrite | None:
+        return self._pending.get(register)
+
+    def overlay(self, regs: dict) -> None:
+        """Apply the pending bits to a register map, e.g. after a poll merged older values."""
+        for register, entry in self._pending.items():
+            if register in regs:
+                regs[register] = entry.apply(regs[register])
+
+    def confirm(self, register: int, value: int, source: str) -> bool:
+        """Resolve the register's entry if value carries all its pending bits. Returns True if resolved."""
+        entry = self._pending.get(register)
+        if entry is None or not entry.matches(value):
+            return False
+        del self._pending[register]
+        self._confirmed[source] += 1
+        _LOGGER.debug("Write of register %s confirmed by %s after %.1fs",
+                      register, source, time_lib.monotonic() - entry.created)
+        return True
+
+    def fail(self, register: int, sequence: int | None = None) -> PendingWrite | None:
+        """Drop the bits of a failed write and return them for reverting.
+
+        Without a sequence the register's whole entry is dropped. With the
+        sequence of the failed submission only the bits it still owns are;
+        None is returned if there is nothing left to revert.
+        """
+        entry = self._pending.get(register)
+        if entry is None:
+            return None
+        failed = entry if sequence is None else entry.release(sequence)
+        if failed is None:
+            return None
+        if failed is entry:
+            del self._pending[register]
+        self._reverted += 1
+        return failed
+
+    def get_stats(self) -> dict:
+        """Return journal statistics for diagnostics."""
+        return {
+            "pending": len(self._pending),
+            "confirmed_by_ack": self._confirmed[SOURCE_ACK],
+            "confirmed_by_read": self._confirmed[SOURCE_READ],
+            "reverted": self._reverted,
+        }
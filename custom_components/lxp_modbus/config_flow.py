@@ -18,6 +18,10 @@ from .const import (
     CONF_CONNECTION_RETRIES,
     CONF_ENABLE_DEVICE_GROUPING,
     CONF_BATTERY_ENTITIES,
+    CONF_BURST_DURATION,
+    CONF_WRITE_DEBOUNCE,
+    CONF_EXPORT_LIMIT,
+    CONF_PARALLEL_GROUP,
     DEFAULT_POLL_INTERVAL,
     DEFAULT_ENTITY_PREFIX,
     DEFAULT_RATED_POWER,
@@ -26,8 +30,13 @@ from .const import (
     DEFAULT_CONNECTION_RETRIES,
     DEFAULT_ENABLE_DEVICE_GROUPING,
     DEFAULT_BATTERY_ENTITIES,
+    DEFAULT_BURST_DURATION,
+    DEFAULT_WRITE_DEBOUNCE,
+    DEFAULT_EXPORT_LIMIT,
+    DEFAULT_PARALLEL_GROUP,
     LEGACY_REGISTER_BLOCK_SIZE,
     SERIAL_LENGTH,
+    CONNECTION_OPTIONS,
 )
 from .classes.inverter_discovery import get_inverter_model_from_device
 
@@ -94,6 +103,10 @@ class LxpModbusConfigFlow(config_entries.ConfigFlow, domain=DOMAIN):
             vol.Required(CONF_CONNECTION_RETRIES, default=DEFAULT_CONNECTION_RETRIES): vol.All(int, vol.Range(min=1, max=10)),
             vol.Optional(CONF_ENABLE_DEVICE_GROUPING, default=DEFAULT_ENABLE_DEVICE_GROUPING): bool,
             vol.Optional(CONF_BATTERY_ENTITIES, default=DEFAULT_BATTERY_ENTITIES): str,
+            vol.Optional(CONF_BURST_DURATION, default=DEFAULT_BURST_DURATION): vol.All(int, vol.Range(min=0, max=600)),
+            vol.Optional(CONF_WRITE_DEBOUNCE, default=DEFAULT_WRITE_DEBOUNCE): vol.All(int, vol.Range(min=0, max=5000)),
+            vol.Optional(CONF_EXPORT_LIMIT, default=DEFAULT_EXPORT_LIMIT): vol.All(int, vol.Range(min=-1, max=100000)),
+            vol.Optional(CONF_PARALLEL_GROUP, default=DEFAULT_PARALLEL_GROUP): str,
         })
         return self.async_show_form(step_id="user", data_schema=self.add_suggested_values_to_schema(data_schema, user_input), errors=errors)
 
@@ -118,22 +131,26 @@ class LxpModbusOptionsFlow(config_entries.OptionsFlow):
                     errors[CONF_CONNECTION_RETRIES] = "invalid_connection_retries"
                 
                 if not errors:
-                    model = await get_inverter_model_from_device(
-                        user_input[CONF_HOST],
-                        user_input[CONF_PORT],
-                        user_input[CONF_DONGLE_SERIAL],
-                        user_input[CONF_INVERTER_SERIAL]
-                    )
+                    # Only a different inverter or dongle needs the model probed again
+                    model = current_config.get("model")
+                    if not model or any(user_input[key] != current_config.get(key) for key in CONNECTION_OPTIONS):
+                        model = await get_inverter_model_from_device(
+                            user_input[CONF_HOST],
+                            user_input[CONF_PORT],
+                            user_input[CONF_DONGLE_SERIAL],
+                            user_input[CONF_INVERTER_SERIAL]
+                        )
                     if not model:
                         errors["base"] = "model_fetch_failed"
                     else:
                         new_data = {**current_config, **user_input}
                         new_data["model"] = model
-                        
+
+                        # The entry's update listener applies polling parameters in place
+                        # and reloads the entry only for other changes
                         self.hass.config_entries.async_update_entry(
                             self.config_entry, data=new_data, options={}
                         )
-                        await self.hass.config_entries.async_reload(self.config_entry.entry_id)
                         return self.async_create_entry(title="", data={})
 
             except vol.Invalid:
@@ -152,6 +169,10 @@ class LxpModbusOptionsFlow(config_entries.OptionsFlow):
             vol.Required(CONF_CONNECTION_RETRIES, default=current_config.get(CONF_CONNECTION_RETRIES, DEFAULT_CONNECTION_RETRIES)): vol.All(int, vol.Range(min=1, max=10)),
             vol.Optional(CONF_ENABLE_DEVICE_GROUPING, default=current_config.get(CONF_ENABLE_DEVICE_GROUPING, DEFAULT_ENABLE_DEVICE_GROUPING)): bool,
             vol.Optional(CONF_BATTERY_ENTITIES, default=current_config.get(CONF_BATTERY_ENTITIES, DEFAULT_BATTERY_ENTITIES)): str,
+            vol.Optional(CONF_BURST_DURATION, default=current_config.get(CONF_BURST_DURATION, DEFAULT_BURST_DURATION)): vol.All(int, vol.Range(min=0, max=600)),
+            vol.Optional(CONF_WRITE_DEBOUNCE, default=current_config.get(CONF_WRITE_DEBOUNCE, DEFAULT_WRITE_DEBOUNCE)): vol.All(int, vol.Range(min=0, max=5000)),
+            vol.Optional(CONF_EXPORT_LIMIT, default=current_config.get(CONF_EXPORT_LIMIT, DEFAULT_EXPORT_LIMIT)): vol.All(int, vol.Range(min=-1, max=100000)),
+            vol.Optional(CONF_PARALLEL_GROUP, default=current_config.get(CONF_PARALLEL_GROUP, DEFAULT_PARALLEL_GROUP)): str,
         })
 
         return self.async_show_form(
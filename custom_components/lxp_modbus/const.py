@@ -25,9 +25,29 @@ CONF_REGISTER_BLOCK_SIZE = "register_block_size"
 CONF_CONNECTION_RETRIES = "connection_retries"
 CONF_ENABLE_DEVICE_GROUPING = "enable_device_grouping"
 CONF_BATTERY_ENTITIES = "battery_entities"
+CONF_BURST_DURATION = "burst_duration"
+CONF_WRITE_DEBOUNCE = "write_debounce"
+CONF_EXPORT_LIMIT = "export_limit"
+CONF_PARALLEL_GROUP = "parallel_group"
 
 INTEGRATION_TITLE = "LuxPower Inverter (Modbus)"
 
+# hass.data[DOMAIN] keys of the DongleHub, IoScheduler and ParallelGroups shared by all config entries
+DATA_HUB = "hub"
+DATA_IO_SCHEDULER = "io_scheduler"
+DATA_GROUPS = "groups"
+
+# Options applied to the running client and coordinator without reloading the entry
+LIVE_RECONFIGURABLE_OPTIONS: Final = (
+    CONF_POLL_INTERVAL,
+    CONF_REGISTER_BLOCK_SIZE,
+    CONF_CONNECTION_RETRIES,
+    CONF_BURST_DURATION,
+    CONF_WRITE_DEBOUNCE,
+)
+# Options that identify the inverter; changing them re-probes the model
+CONNECTION_OPTIONS: Final = (CONF_HOST, CONF_PORT, CONF_DONGLE_SERIAL, CONF_INVERTER_SERIAL)
+
 
 DEFAULT_POLL_INTERVAL = 60  # seconds
 DEFAULT_ENTITY_PREFIX = ""
@@ -38,6 +58,10 @@ DEFAULT_REGISTER_BLOCK_SIZE = 125
 DEFAULT_CONNECTION_RETRIES = 3
 DEFAULT_ENABLE_DEVICE_GROUPING = True
 DEFAULT_BATTERY_ENTITIES = "none"  # User must explicitly enable; not all batteries provide data
+DEFAULT_BURST_DURATION = 60  # seconds of burst polling after a state transition, 0 disables
+DEFAULT_WRITE_DEBOUNCE = 500  # milliseconds during which number writes are coalesced, 0 disables
+DEFAULT_EXPORT_LIMIT = -1  # watts of grid export the controller holds, -1 disables it
+DEFAULT_PARALLEL_GROUP = ""  # entries with the same group name form a parallel group
 
 # Legacy firmware may only support smaller block sizes
 LEGACY_REGISTER_BLOCK_SIZE = 40
@@ -52,12 +76,130 @@ RESPONSE_OVERHEAD: Final = 37  # Minimum response length from inverter (protocol
 WRITE_RESPONSE_LENGTH = 76  # Based on documentation for a single write ack
 
 BATTERY_INFO_START_REGISTER = 5000  # Start of battery info register range
+BATTERY_BLOCK_REGISTERS = 30  # Registers per battery pack, packs follow each other from 5000
+BATTERY_MAX_PACKS = 32  # Upper bound for the reported pack count, guards against implausible values
+# Battery packs are read on their own schedule after the input and hold registers; a pack
+# goes unavailable once its block has not been decoded for BATTERY_STALE_AFTER
+BATTERY_POLL_INTERVAL = 300  # seconds between reads of the same battery page
+BATTERY_STALE_AFTER = 900  # seconds
+# A page that answers this many reads in a row without any pack serial is taken as empty
+BATTERY_EMPTY_PAGE_READS = 3
+
+# Register tiers: the fast tier holds real-time telemetry (state, power flows, faults,
+# warnings, parallel status), the slow tier everything else.
+TIER_FAST = "fast"
+TIER_SLOW = "slow"
+FAST_TIER_INPUT_END = 125  # Input blocks starting below this register belong to the fast tier
+
+# Burst polling: poll the fast tier at the maximum dongle rate after a state transition
+BURST_POLL_INTERVAL = 2  # seconds, same as the minimum allowed poll interval
+
+# Poll budget: each cycle may spend this fraction of the poll interval on the dongle.
+# Fast-tier blocks are always read; slow-tier blocks rotate round-robin within the
+# budget and are forced into a cycle once they have lagged ROTATION_MAX_LAG_CYCLES.
+POLL_BUDGET_FRACTION = 0.8
+ROTATION_MAX_LAG_CYCLES = 10
+POLL_BLOCK_RTT_ESTIMATE = 0.5  # seconds assumed for a block that has not been read yet
+POLL_RTT_SMOOTHING = 0.3  # weight of the newest sample in the per-block read time average
 
 # Communication timeouts (seconds)
 READ_TIMEOUT = 3
 WRITE_RETRY_DELAY = 1
-INITIAL_RETRY_DELAY = 30
-RETRY_BACKOFF_MULTIPLIER = 1.5
+
+# Writes are skipped when the inverter confirmed the target value at most this long ago
+# (through a poll or a write echo); optimistic entity updates do not count
+WRITE_SKIP_MAX_AGE = 120  # seconds
+
+# Bit changes to the same register within this window are merged into one read-modify-write
+RMW_BATCH_WINDOW = 0.2  # seconds
+
+# Entity writes are shown optimistically and confirmed in the background; a write that
+# fails reverts the entity and fires this event
+EVENT_WRITE_REVERTED = f"{DOMAIN}_write_reverted"
+
+# Register transactions (profiles): contiguous changes are sent as write-multiple frames of
+# at most this many registers, the legacy block size every firmware accepts
+MULTI_WRITE_MAX_REGISTERS = 40
+EVENT_PROFILE_APPLIED = f"{DOMAIN}_profile_applied"
+
+# Services
+SERVICE_APPLY_PROFILE = "apply_profile"
+SERVICE_FORCE_CHARGE = "force_charge"
+SERVICE_SET_SCHEDULE = "set_schedule"
+SERVICE_GROUP_WRITE = "group_write"
+SERVICE_DUMP_FRAMES = "dump_frames"
+ATTR_GROUP = "group"
+ATTR_ENTRY_ID = "entry_id"
+ATTR_PROFILE = "profile"
+ATTR_REGISTERS = "registers"
+ATTR_TARGET_SOC = "target_soc"
+ATTR_DURATION = "duration"
+ATTR_CHARGE_CURRENT = "charge_current"
+
+# Group writes apply one register transaction to every member of a parallel group
+EVENT_GROUP_WRITE = f"{DOMAIN}_group_write"
+
+# Forced charge: charges from the grid through AC charge time window 2 until the target
+# SOC (read from the fast tier) or the deadline is reached, then restores the settings
+EVENT_FORCE_CHARGE_FINISHED = f"{DOMAIN}_force_charge_finished"
+FORCE_CHARGE_MAX_DURATION = 720  # minutes, keeps the time window shorter than a day
+
+# Export limit controller: adjusts the feed-in limit (percent of rated power) from the
+# grid power read on the fast tier, polled every EXPORT_CONTROL_PERIOD while it runs
+EXPORT_CONTROL_PERIOD = 3  # seconds between fast-tier polls
+EXPORT_CONTROL_HYSTERESIS = 50  # watts around the limit within which the setting is held
+EXPORT_CONTROL_MAX_STEP = 10  # percent the feed-in limit may change per adjustment
+EXPORT_CONTROL_MIN_WRITE_INTERVAL = 6  # seconds between adjustments, lets the inverter settle
+# The feed-in limit is kept in the inverter's EEPROM: at most this many adjustments per window
+EXPORT_CONTROL_WRITE_BUDGET = 60
+EXPORT_CONTROL_BUDGET_WINDOW = 3600  # seconds
+
+# Global I/O scheduler: limits dongle operations in flight across all entries (writes are
+# admitted before polls) and staggers the first poll of entries set up together
+IO_MAX_CONCURRENT = 2
+IO_POLL_STAGGER = 2  # seconds between the first polls of successive entries
+IO_THROUGHPUT_WINDOW = 60  # seconds over which operations per minute are measured
+
+# Parallel groups: members poll on shared cycle boundaries; a read up to this many seconds
+# before a boundary still belongs to that cycle (refresh timers have sub-second jitter)
+GROUP_ALIGN_TOLERANCE = 1  # seconds
+# A member's fast tier counts towards a cycle only if it was read within this many seconds
+# of the cycle start (connect, initial discard and queueing come first); at most half a period
+GROUP_READ_WINDOW = 5  # seconds
+# System totals go unavailable once no cycle has completed for this many cycle periods
+GROUP_STALE_CYCLES = 3
+
+# Latency histograms: dongle timings (connect, block read, poll cycle, queue wait, write
+# acknowledgement) are counted in logarithmic buckets for p50/p95/p99 diagnostics
+LATENCY_CONNECT = "connect"
+LATENCY_BLOCK = "block_read"
+LATENCY_CYCLE = "poll_cycle"
+LATENCY_QUEUE_WAIT = "queue_wait"
+LATENCY_WRITE = "write_ack"
+LATENCY_MIN_MS = 1
+LATENCY_MAX_MS = 60000
+LATENCY_BUCKETS_PER_OCTAVE = 4
+
+# Raw frames sent to and received from the dongle are kept in a ring buffer of this many
+# frames, dumped through the diagnostics download or the dump_frames service
+FRAME_TRACE_SIZE = 200
+
+# Dongle circuit breaker: after CONF_CONNECTION_RETRIES consecutive failures all traffic
+# to the dongle pauses for a jittered, exponentially growing delay before one probe is sent
+BREAKER_BASE_DELAY = 15  # seconds before the first probe
+BREAKER_MAX_DELAY = 300  # upper bound for the backoff delay
+BREAKER_JITTER = 0.2  # +/- fraction applied to each delay
+
+# Identity read at setup: the firmware code registers used for the device info
+IDENTITY_HOLD_START = 7
+IDENTITY_HOLD_COUNT = 4
+
+# Register snapshot persisted through Home Assistant storage for instant startup
+SNAPSHOT_STORAGE_VERSION = 1
+SNAPSHOT_SAVE_DELAY = 300  # seconds, at most one snapshot write per interval
+
+# Interrupted force charge persisted until its settings have been restored
+FORCE_CHARGE_STORAGE_VERSION = 1
 
 # Failure thresholds for cached/empty data fallback
 MAX_CACHED_DATA_FAILURES = 5
@@ -1,29 +1,25 @@
 """DataUpdateCoordinator for the LuxPower Modbus integration."""
+import asyncio
 import logging
+import math
 import time as time_lib
 from datetime import timedelta
 
 from homeassistant.core import HomeAssistant, callback
-from homeassistant.helpers.event import async_track_time_interval
 from homeassistant.helpers.update_coordinator import DataUpdateCoordinator, UpdateFailed
 
-from .const import INTEGRATION_TITLE
+from .classes.burst_trigger import BurstTrigger
+from .classes.circuit_breaker import STATE_CLOSED
+from .const import BURST_POLL_INTERVAL, DEFAULT_BURST_DURATION, EVENT_WRITE_REVERTED, INTEGRATION_TITLE, TIER_FAST
 
 _LOGGER = logging.getLogger(__name__)
 
-# Recovery mode constants
-RECOVERY_MODE_THRESHOLD = 3
-RECOVERY_INTERVAL_INITIAL = 15
-RECOVERY_INTERVAL_MEDIUM = 30
-RECOVERY_INTERVAL_HIGH = 60
-RECOVERY_ESCALATION_MEDIUM = 10
-RECOVERY_ESCALATION_HIGH = 20
-
 
 class LxpModbusDataUpdateCoordinator(DataUpdateCoordinator):
     """Class to manage fetching LuxPower Modbus data."""
 
-    def __init__(self, hass: HomeAssistant, api_client, poll_interval: int, entry_title: str):
+    def __init__(self, hass: HomeAssistant, api_client, poll_interval: int, entry_title: str,
+                 burst_duration: int = DEFAULT_BURST_DURATION):
         """Initialize the coordinator."""
         super().__init__(
             hass,
@@ -35,72 +31,237 @@ class LxpModbusDataUpdateCoordinator(DataUpdateCoordinator):
         self.api_client = api_client
         self._failed_updates = 0
         self._last_success = None
-        self._is_recovering = False
-        self._recovery_interval = None
         self._original_poll_interval = poll_interval
+        self._burst_duration = burst_duration
+        self._burst_trigger = BurstTrigger()
+        self._burst_until = None
+        self._inflight_poll = None
+        self._refresh_queued = False
+        self._joined_polls = 0
+        self._first_poll_done = False
+        self._fast_poll_interval = None
+        self._last_full_poll = None
+        self._group = None
+        self._group_member = None
+        self.cycle_id = None
+        self._battery_listeners = []
+        api_client.on_write_resolved = self._async_write_resolved
+        api_client.on_battery_change = self._async_battery_change
+
+    @property
+    def is_bursting(self) -> bool:
+        """Return True while the fast tier is polled at the burst rate."""
+        return self._burst_until is not None
+
+    @property
+    def joined_polls(self) -> int:
+        """Number of refreshes that joined an in-flight poll instead of starting one."""
+        return self._joined_polls
+
+    @property
+    def poll_interval(self) -> int:
+        """Return the configured polling interval in seconds."""
+        return self._original_poll_interval
+
+    def join_group(self, group, member: str | None) -> None:
+        """Poll on the cycle boundaries of a parallel group (None leaves it)."""
+        self._group = group
+        self._group_member = member
+        self.cycle_id = None
+        self._schedule_next_poll()
+
+    def set_fast_poll_interval(self, interval: int | None) -> None:
+        """Poll the fast tier every interval seconds, e.g. for a control loop; None stops it.
+
+        Full polls still run once per poll interval in between.
+        """
+        self._fast_poll_interval = interval
+        self._schedule_next_poll()
+
+    def reconfigure(self, poll_interval: int | None = None, burst_duration: int | None = None) -> None:
+        """Apply a new poll interval or burst duration without recreating the coordinator."""
+        if poll_interval is not None:
+            self._original_poll_interval = poll_interval
+        if burst_duration is not None:
+            self._burst_duration = burst_duration
+            if burst_duration <= 0:
+                self._burst_until = None
+        # Transitions are detected against the next poll, not the state before the change
+        self._burst_trigger.reset()
+        self._schedule_next_poll()
+
+    async def async_request_refresh(self) -> None:
+        """Request a refresh, coalescing with a poll that is already running.
+
+        While a poll is in flight the request is only remembered; a single
+        follow-up poll runs after the current one ends, however many requests
+        arrived in the meantime.
+        """
+        if self._inflight_poll is not None:
+            self._refresh_queued = True
+            return
+        await super().async_request_refresh()
 
     async def _async_update_data(self):
+        """Fetch data with single-flight semantics.
+
+        Every refresh path (regular interval, delayed setup refresh, button
+        presses) ends up here. Callers arriving while a poll is in flight join
+        it and receive its result instead of queueing another full poll behind
+        the client lock. If the poll is cancelled, only its own caller is; the
+        joined callers get UpdateFailed.
+        """
+        if self._inflight_poll is not None:
+            self._joined_polls += 1
+            _LOGGER.debug("Refresh joined the in-flight poll")
+            return await asyncio.shield(self._inflight_poll)
+
+        future = asyncio.get_running_loop().create_future()
+        self._inflight_poll = future
+        try:
+            data = await self._async_poll()
+        except asyncio.CancelledError:
+            future.set_exception(UpdateFailed("Poll was cancelled"))
+            future.exception()
+            raise
+        except Exception as err:
+            future.set_exception(err)
+            # Mark the exception as retrieved in case no caller joined this poll
+            future.exception()
+            raise
+        else:
+            future.set_result(data)
+            return data
+        finally:
+            self._inflight_poll = None
+            if self._refresh_queued:
+                self._refresh_queued = False
+                self.hass.async_create_task(self.async_refresh())
+
+    @callback
+    def _async_publish_partial(self, data: dict):
+        """Push a partially polled dataset to the entities during the first poll."""
+        self.data = data
+        self.async_update_listeners()
+
+    @callback
+    def _async_write_resolved(self, register: int, attempted: int, restored: int | None):
+        """Refresh entities once an optimistically shown write is confirmed or reverted."""
+        if restored is not None:
+            self.hass.bus.async_fire(EVENT_WRITE_REVERTED, {
+                "register": register, "attempted": attempted, "restored": restored})
+        if self.data is not None:
+            self.async_update_listeners()
+
+    @callback
+    def async_add_battery_listener(self, listener):
+        """Call listener(added, removed) when battery packs appear or disappear; returns a function removing it."""
+        self._battery_listeners.append(listener)
+        return lambda: self._battery_listeners.remove(listener)
+
+    def _async_battery_change(self, added: set, removed: set):
+        for listener in list(self._battery_listeners):
+            listener(added, removed)
+
+    async def _async_poll(self):
         """Fetch data from API endpoint."""
+        self._check_burst_expired()
         try:
-            data = await self.api_client.async_get_data()
+            # Until the first poll has completed, entities are updated block by block
+            tiers = self._select_tiers()
+            data = await self.api_client.async_get_data(
+                tiers=tiers,
+                on_block=None if self._first_poll_done else self._async_publish_partial,
+            )
+            if tiers is None:
+                self._last_full_poll = time_lib.monotonic()
+                self._record_group_cycle()
+            # Keep publishing block by block until a poll has actually read the inverter
+            if self.api_client.last_poll_live:
+                self._first_poll_done = True
             self._failed_updates = 0
             self._last_success = time_lib.time()
-
-            # If we were in recovery mode, go back to normal
-            if self._is_recovering:
-                _LOGGER.info("Connection recovered! Resuming normal polling schedule.")
-                self._is_recovering = False
-                if self._recovery_interval:
-                    self._recovery_interval()
-                    self._recovery_interval = None
-                # Restore normal update interval
-                self.update_interval = timedelta(seconds=self._original_poll_interval)
-
+            if self.api_client.last_poll_live:
+                self._check_burst_trigger(data.get("input", {}))
+            else:
+                # Cached data: a transition during the gap must not start a burst on recovery
+                self._burst_trigger.reset()
             return data
-        except UpdateFailed as err:
+        except UpdateFailed:
+            # After several consecutive failures the client raises so that
+            # entities show as unavailable
             self._failed_updates += 1
+            self._burst_trigger.reset()
+            raise
+        finally:
+            self._schedule_next_poll()
+
+    def _record_group_cycle(self):
+        """Record the live fast tier with the group cycle in which it was actually read."""
+        read_at = self.api_client.last_fast_tier_read
+        # Cached data must not complete a group cycle, nor may a read delayed past the cycle's window
+        if (self._group is None or read_at is None
+                or TIER_FAST not in self.api_client.last_poll_live_tiers):
+            return
+        cycle = self._group.cycle_of_read(read_at)
+        if cycle is None:
+            _LOGGER.debug("Fast tier read outside the group cycle window, not recorded")
+            return
+        self.cycle_id = cycle
+        self._group.record(self._group_member, cycle, self.api_client.last_fast_tier_inputs)
+
+    def _select_tiers(self):
+        """Return the tiers for this poll: the fast tier only while bursting or between full polls of a fast loop."""
+        if self.is_bursting:
+            return (TIER_FAST,)
+        if (self._fast_poll_interval is not None and self._last_full_poll is not None
+                and time_lib.monotonic() - self._last_full_poll < self._original_poll_interval):
+            return (TIER_FAST,)
+        return None
 
-            # Start recovery mode if we're not already in it
-            if not self._is_recovering and self._failed_updates >= RECOVERY_MODE_THRESHOLD:
-                self._start_recovery_mode()
+    def _schedule_next_poll(self):
+        """Derive the next polling interval from the dongle circuit breaker and burst window.
 
-            # After several consecutive failures, we should still raise the error
-            # to make sure the entities show as unavailable
-            raise err
+        While the circuit is open the next poll is scheduled for the moment the
+        breaker lets a probe through (never later than the normal interval),
+        so there is no separate recovery timer competing with the schedule.
+        """
+        breaker = self.api_client.circuit_breaker
+        if breaker.state != STATE_CLOSED:
+            interval = min(self._original_poll_interval, max(BURST_POLL_INTERVAL, math.ceil(breaker.retry_in)))
+        elif self.is_bursting:
+            interval = BURST_POLL_INTERVAL
+        elif self._fast_poll_interval is not None:
+            interval = min(self._original_poll_interval, self._fast_poll_interval)
+        elif self._group is not None and self._group.period:
+            # Land on the next cycle boundary shared by all members
+            interval = self._group.seconds_to_next_cycle()
+        else:
+            interval = self._original_poll_interval
 
-    def _start_recovery_mode(self):
-        """Start a more aggressive reconnection strategy."""
-        if self._is_recovering:
+        new_interval = timedelta(seconds=interval)
+        if self.update_interval != new_interval:
+            _LOGGER.debug("Next poll in %ss (circuit %s, burst %s)", interval, breaker.state, self.is_bursting)
+            self.update_interval = new_interval
+
+    def _check_burst_trigger(self, input_regs: dict):
+        """Start or extend a burst if the freshly polled data shows a state transition."""
+        reason = self._burst_trigger.detect(input_regs)
+        if not reason or self._burst_duration <= 0:
             return
 
-        self._is_recovering = True
-        _LOGGER.warning("Connection lost! Starting recovery mode with more frequent reconnection attempts.")
-
-        # Switch to a more aggressive polling schedule during recovery,
-        # gradually increasing the interval if still failing
-        recovery_interval = RECOVERY_INTERVAL_INITIAL
-        if self._failed_updates > RECOVERY_ESCALATION_MEDIUM:
-            recovery_interval = RECOVERY_INTERVAL_MEDIUM
-        if self._failed_updates > RECOVERY_ESCALATION_HIGH:
-            recovery_interval = RECOVERY_INTERVAL_HIGH
-
-        self.update_interval = timedelta(seconds=recovery_interval)
-
-        # Also set up a periodic forced refresh that runs in parallel
-        # to the regular update schedule
-        @callback
-        def periodic_recovery_refresh(now=None):
-            """Force a refresh on a timer."""
-            _LOGGER.debug("Recovery mode: forcing a refresh attempt (fail count: %s)", self._failed_updates)
-            self.async_refresh()
-
-        # Cancel any existing recovery interval
-        if self._recovery_interval:
-            self._recovery_interval()
-
-        # Set up a recurring timer for forced refresh attempts
-        self._recovery_interval = async_track_time_interval(
-            self.hass,
-            periodic_recovery_refresh,
-            timedelta(seconds=recovery_interval)
-        )
+        if not self.is_bursting:
+            _LOGGER.info("Inverter %s: burst polling the fast tier every %ss for %ss",
+                         reason, BURST_POLL_INTERVAL, self._burst_duration)
+        else:
+            _LOGGER.debug("Inverter %s: extending burst polling window", reason)
+
+        self._burst_until = time_lib.monotonic() + self._burst_duration
+
+    def _check_burst_expired(self):
+        """Fall back to a full poll once the burst window is over."""
+        if self._burst_until is None or time_lib.monotonic() < self._burst_until:
+            return
+
+        _LOGGER.info("Burst polling window ended, resuming normal polling schedule.")
+        self._burst_until = None
@@ -0,0 +1,56 @@
+"""Diagnostics download for the LuxPower Modbus integration."""
+from homeassistant.components.diagnostics import REDACTED, async_redact_data
+from homeassistant.config_entries import ConfigEntry
+from homeassistant.core import HomeAssistant
+
+from .const import DOMAIN, CONF_HOST, CONF_DONGLE_SERIAL, CONF_INVERTER_SERIAL
+
+TO_REDACT = {CONF_HOST, CONF_DONGLE_SERIAL, CONF_INVERTER_SERIAL}
+
+
+def _redact_values(data, values):
+    """Replace the given values in the strings of the statistics, e.g. connection errors naming the host."""
+    if isinstance(data, dict):
+        return {key: _redact_values(value, values) for key, value in data.items()}
+    if isinstance(data, list):
+        return [_redact_values(value, values) for value in data]
+    if isinstance(data, str):
+        for value in values:
+            data = data.replace(value, REDACTED)
+    return data
+
+
+async def async_get_config_entry_diagnostics(hass: HomeAssistant, entry: ConfigEntry) -> dict:
+    """Return the entry settings and the runtime statistics of its client and coordinator."""
+    entry_data = hass.data.get(DOMAIN, {}).get(entry.entry_id, {})
+    coordinator = entry_data.get("coordinator")
+    api_client = entry_data.get("api_client")
+
+    diagnostics = {
+        "entry": {
+            "title": entry.title,
+            "data": async_redact_data(dict(entry.data), TO_REDACT),
+            "options": async_redact_data(dict(entry.options), TO_REDACT),
+        },
+    }
+    if coordinator is not None:
+        diagnostics["coordinator"] = {
+            "poll_interval": coordinator.poll_interval,
+            "is_bursting": coordinator.is_bursting,
+            "joined_polls": coordinator.joined_polls,
+            "last_update_success": coordinator.last_update_success,
+        }
+    if api_client is not None:
+        # Includes the latency histograms, packet recovery and scheduler statistics. The battery
+        # statistics (also the Stale Battery Packs attributes) list the serials of stale packs
+        client = api_client.get_diagnostics()
+        battery_serials = set(client["batteries"]["stale"])
+        if coordinator is not None and coordinator.data:
+            battery_serials.update(coordinator.data.get("battery", {}))
+        sensitive = {entry.data.get(key) for key in TO_REDACT} | battery_serials
+        # Longest first, so a serial containing another one is replaced whole
+        diagnostics["client"] = _redact_values(
+            client, sorted((value for value in sensitive if value), key=len, reverse=True))
+        diagnostics["client"]["data_is_stale"] = api_client.data_is_stale
+        diagnostics["frames"] = api_client.frame_trace.dump(mask_serials=True)
+    return diagnostics
@@ -1,6 +1,7 @@
 """Base class for LuxPower Modbus entities."""
 import logging
 from homeassistant.helpers.update_coordinator import DataUpdateCoordinator, CoordinatorEntity
+from homeassistant.const import EntityCategory
 from homeassistant.helpers.entity import generate_entity_id
 from .utils import format_firmware_version
 from .const import DOMAIN, INTEGRATION_TITLE, CONF_INVERTER_SERIAL, CONF_ENABLE_DEVICE_GROUPING, DEFAULT_ENABLE_DEVICE_GROUPING
@@ -37,6 +38,8 @@ class ModbusBridgeEntity(CoordinatorEntity):
 
         self._attr_entity_registry_enabled_default = self._desc.get("enabled", True)
         self._attr_entity_registry_visible_default = self._desc.get("visible", True)
+        if "entity_category" in self._desc:
+            self._attr_entity_category = EntityCategory(self._desc["entity_category"])
 
         is_master_only_control = self._desc.get("master_only", False)
         if is_master_only_control and not self.is_master:
@@ -50,6 +53,9 @@ class ModbusBridgeEntity(CoordinatorEntity):
             else:
                 self._attr_unique_id = f"{entity_prefix}_{dependencies_str}_{id_name}"
             self._register = None
+        elif self._register_type == "diagnostic":
+            self._attr_unique_id = f"{entity_prefix}_diag_{self._desc['key']}"
+            self._register = None
         else:
             self._register = self._desc["register"]
             if self._register_type == "battery":
@@ -61,12 +67,20 @@ class ModbusBridgeEntity(CoordinatorEntity):
     @property
     def extra_state_attributes(self):
         """Return the state attributes."""
+        if self._register_type == "diagnostic":
+            attributes = self._desc.get("attributes")
+            return attributes(self._api_client.get_diagnostics()) if attributes and self._api_client else None
         if self._register_type.endswith("calculated"):
-            return {"dependencies": self._desc.get("depends_on")}
-        return {
-            "register": self._register,
-            "register_type": self._register_type,
-        }
+            attributes = {"dependencies": self._desc.get("depends_on")}
+        else:
+            attributes = {
+                "register": self._register,
+                "register_type": self._register_type,
+            }
+        # Values restored from the startup snapshot until the first live poll
+        if self._api_client is not None and self._api_client.data_is_stale:
+            attributes["stale"] = True
+        return attributes
 
 
     @property
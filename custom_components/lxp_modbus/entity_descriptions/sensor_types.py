@@ -7,8 +7,21 @@ from ..constants.hold_registers import H_NO_FULL_CHG_DAY_CONFIG, H_BOOTLOADER_VE
 from ..constants.battery_registers import *
 from ..constants.fault_codes import FAULT_CODES
 from ..constants.warning_codes import WARNING_CODES
-from ..const import CONF_RATED_POWER
-from ..utils import decode_bitmask_to_string, get_highest_set_bit
+from ..const import (
+    CONF_RATED_POWER,
+    LATENCY_BLOCK,
+    LATENCY_CONNECT,
+    LATENCY_CYCLE,
+    LATENCY_QUEUE_WAIT,
+    LATENCY_WRITE,
+)
+from ..utils import (
+    decode_bitmask_to_string,
+    get_highest_set_bit,
+    grid_export_total,
+    grid_import_total,
+    pv_power_total,
+)
 
 SENSOR_TYPES = [
     # --- Calculated Sensors ---
@@ -3172,3 +3185,241 @@ BATTERY_SENSOR_TYPES = [
         "visible": True,
     },
 ]
+
+# Diagnostic sensors read the runtime state of the API client (not inverter registers).
+# "extract" and "attributes" receive the dict returned by LxpModbusApiClient.get_diagnostics().
+
+
+def _latency_sensor(name: str, key: str, icon: str) -> dict:
+    """Describe a sensor showing the p95 of a latency histogram, with p50/p99 as attributes."""
+    return {
+        "name": name,
+        "key": f"latency_{key}",
+        "register_type": "diagnostic",
+        "extract": lambda diagnostics: diagnostics["latency"][key]["p95"],
+        "attributes": lambda diagnostics: diagnostics["latency"][key],
+        "unit": "ms",
+        "device_class": "duration",
+        "state_class": "measurement",
+        "icon": icon,
+        "entity_category": "diagnostic",
+        "enabled": True,
+        "visible": True,
+    }
+
+
+DIAGNOSTIC_SENSOR_TYPES = [
+    {
+        "name": "Dongle Connection State",
+        "key": "circuit_breaker_state",
+        "register_type": "diagnostic",
+        "extract": lambda diagnostics: diagnostics["circuit_breaker"]["state"],
+        "attributes": lambda diagnostics: diagnostics["circuit_breaker"],
+        "icon": "mdi:lan-connect",
+        "entity_category": "diagnostic",
+        "enabled": True,
+        "visible": True,
+    },
+    {
+        "name": "Poll Cycle Overruns",
+        "key": "poll_cycle_overruns",
+        "register_type": "diagnostic",
+        "extract": lambda diagnostics: diagnostics["poll_scheduler"]["overruns"],
+        "attributes": lambda diagnostics: diagnostics["poll_scheduler"],
+        "state_class": "total_increasing",
+        "icon": "mdi:timer-alert-outline",
+        "entity_category": "diagnostic",
+        "enabled": True,
+        "visible": True,
+    },
+    {
+        "name": "Poll Rotation Lag",
+        "key": "poll_rotation_lag",
+        "register_type": "diagnostic",
+        "extract": lambda diagnostics: diagnostics["poll_scheduler"]["max_rotation_lag"],
+        "attributes": lambda diagnostics: diagnostics["poll_scheduler"],
+        "unit": "cycles",
+        "state_class": "measurement",
+        "icon": "mdi:rotate-right",
+        "entity_category": "diagnostic",
+        "enabled": True,
+        "visible": True,
+    },
+    {
+        "name": "Skipped Redundant Writes",
+        "key": "skipped_writes",
+        "register_type": "diagnostic",
+        "extract": lambda diagnostics: diagnostics["skipped_writes"],
+        "state_class": "total_increasing",
+        "icon": "mdi:content-save-off-outline",
+        "entity_category": "diagnostic",
+        "enabled": True,
+        "visible": True,
+    },
+    {
+        "name": "Reverted Writes",
+        "key": "reverted_writes",
+        "register_type": "diagnostic",
+        "extract": lambda diagnostics: diagnostics["write_journal"]["reverted"],
+        "attributes": lambda diagnostics: diagnostics["write_journal"],
+        "state_class": "total_increasing",
+        "icon": "mdi:undo-variant",
+        "entity_category": "diagnostic",
+        "enabled": True,
+        "visible": True,
+    },
+    {
+        "name": "Dongle I/O Queue Depth",
+        "key": "io_queue_depth",
+        "register_type": "diagnostic",
+        "extract": lambda diagnostics: diagnostics["io_scheduler"]["queue_depth"],
+        "attributes": lambda diagnostics: diagnostics["io_scheduler"],
+        "state_class": "measurement",
+        "icon": "mdi:tray-full",
+        "entity_category": "diagnostic",
+        "enabled": True,
+        "visible": True,
+    },
+    {
+        "name": "Dongle I/O Throughput",
+        "key": "io_throughput",
+        "register_type": "diagnostic",
+        "extract": lambda diagnostics: diagnostics["io_scheduler"]["operations_per_minute"],
+        "unit": "operations/min",
+        "state_class": "measurement",
+        "icon": "mdi:speedometer",
+        "entity_category": "diagnostic",
+        "enabled": True,
+        "visible": True,
+    },
+    {
+        "name": "Stale Battery Packs",
+        "key": "stale_battery_packs",
+        "register_type": "diagnostic",
+        "extract": lambda diagnostics: len(diagnostics["batteries"]["stale"]),
+        "attributes": lambda diagnostics: diagnostics["batteries"],
+        "state_class": "measurement",
+        "icon": "mdi:battery-clock",
+        "entity_category": "diagnostic",
+        "enabled": True,
+        "visible": True,
+    },
+    _latency_sensor("Dongle Connect Time", LATENCY_CONNECT, "mdi:lan-connect"),
+    _latency_sensor("Block Read Time", LATENCY_BLOCK, "mdi:timer-outline"),
+    _latency_sensor("Poll Cycle Duration", LATENCY_CYCLE, "mdi:timer-sync-outline"),
+    _latency_sensor("Dongle Queue Wait", LATENCY_QUEUE_WAIT, "mdi:timer-sand"),
+    _latency_sensor("Write Acknowledgement Time", LATENCY_WRITE, "mdi:timer-edit-outline"),
+]
+
+# Parallel group sensors combine the members of a parallel group (see group.py).
+# "extract" receives {entry_id: input registers} of the last complete cycle and the owning entry.
+# Per-inverter totals come from the utils helpers, which pick the registers of each model family.
+_GROUP_PV = [I_PPV1, I_PPV2, I_PPV3, I_PPV4, I_PPV5, I_PPV6, I_VPV3]
+_GROUP_TO_GRID = [I_PTOGRID, I_PTOGRID_S, I_PTOGRID_T, I_VAC_S, I_VAC_T]
+_GROUP_TO_USER = [I_PTOUSER, I_PTOUSER_S, I_PTOUSER_T, I_VAC_S, I_VAC_T]
+
+
+def _group_sum(members: dict, registers: list) -> int:
+    return sum(regs.get(register, 0) for regs in members.values() for register in registers)
+
+
+def _group_total(members: dict, inverter_total) -> int:
+    return sum(inverter_total(regs) for regs in members.values())
+
+
+GROUP_SENSOR_TYPES = [
+    {
+        "name": "System PV Power",
+        "key": "pv_power",
+        "register_type": "group_calculated",
+        "depends_on": _GROUP_PV,
+        "unit": "W",
+        "device_class": "power",
+        "state_class": "measurement",
+        "icon": "mdi:solar-power",
+        "extract": lambda members, entry: _group_total(members, pv_power_total),
+    },
+    {
+        "name": "System Battery Charge Power",
+        "key": "battery_charge_power",
+        "register_type": "group_calculated",
+        "depends_on": [I_PCHARGE],
+        "unit": "W",
+        "device_class": "power",
+        "state_class": "measurement",
+        "icon": "mdi:battery-arrow-up",
+        "extract": lambda members, entry: _group_sum(members, [I_PCHARGE]),
+    },
+    {
+        "name": "System Battery Discharge Power",
+        "key": "battery_discharge_power",
+        "register_type": "group_calculated",
+        "depends_on": [I_PDISCHARGE],
+        "unit": "W",
+        "device_class": "power",
+        "state_class": "measurement",
+        "icon": "mdi:battery-arrow-down",
+        "extract": lambda members, entry: _group_sum(members, [I_PDISCHARGE]),
+    },
+    {
+        "name": "System Grid Export Power",
+        "key": "grid_export_power",
+        "register_type": "group_calculated",
+        "depends_on": _GROUP_TO_GRID,
+        "unit": "W",
+        "device_class": "power",
+        "state_class": "measurement",
+        "icon": "mdi:transmission-tower-export",
+        "extract": lambda members, entry: _group_total(members, grid_export_total),
+    },
+    {
+        "name": "System Grid Import Power",
+        "key": "grid_import_power",
+        "register_type": "group_calculated",
+        "depends_on": _GROUP_TO_USER,
+        "unit": "W",
+        "device_class": "power",
+        "state_class": "measurement",
+        "icon": "mdi:transmission-tower-import",
+        "extract": lambda members, entry: _group_total(members, grid_import_total),
+    },
+    {
+        "name": "System EPS Power",
+        "key": "eps_power",
+        "register_type": "group_calculated",
+        "depends_on": [I_PEPS],
+        "unit": "W",
+        "device_class": "power",
+        "state_class": "measurement",
+        "icon": "mdi:power-plug-battery",
+        "extract": lambda members, entry: _group_sum(members, [I_PEPS]),
+    },
+    {
+        "name": "System Load Power",
+        "key": "load_power",
+        "register_type": "group_calculated",
+        "depends_on": [I_PLOAD],
+        "unit": "W",
+        "device_class": "power",
+        "state_class": "measurement",
+        "icon": "mdi:home-lightning-bolt",
+        "extract": lambda members, entry: _group_sum(members, [I_PLOAD]),
+    },
+    {
+        "name": "System Battery SOC",
+        "key": "battery_soc",
+        "register_type": "group_calculated",
+        "depends_on": [I_SOC_SOH],
+        "unit": "%",
+        "device_class": "battery",
+        "state_class": "measurement",
+        "icon": "mdi:battery",
+        "extract": lambda members, entry: (
+            round(sum(regs[I_SOC_SOH] & 0xFF for regs in with_soc) / len(with_soc))
+            if (with_soc := [regs for regs in members.values() if I_SOC_SOH in regs]) else None
+        ),
+    },
+]
+
+# Input registers the group sensors depend on; pinned to the fast tier of every member
+GROUP_INPUT_REGISTERS = sorted({register for desc in GROUP_SENSOR_TYPES for register in desc["depends_on"]})
@@ -0,0 +1,125 @@
+"""Closed-loop export limit controller running on the fast telemetry tier."""
+import logging
+import math
+import time as time_lib
+from collections import deque
+
+from homeassistant.core import callback
+
+from .classes.bitfield_writer import REGISTER_MASK
+from .const import (
+    EXPORT_CONTROL_BUDGET_WINDOW,
+    EXPORT_CONTROL_HYSTERESIS,
+    EXPORT_CONTROL_MAX_STEP,
+    EXPORT_CONTROL_MIN_WRITE_INTERVAL,
+    EXPORT_CONTROL_PERIOD,
+    EXPORT_CONTROL_WRITE_BUDGET,
+    TIER_FAST,
+)
+from .constants.hold_registers import H_MAX_BACKFLOW_POWER
+from .utils import grid_export_total, grid_import_total, grid_power_registers
+
+_LOGGER = logging.getLogger(__name__)
+
+PIN_KEY = "export_control"
+
+
+def next_feed_in_percent(current: int, export: int, limit: int, rated_power: int) -> int | None:
+    """Return the feed-in limit that moves the grid export towards limit watts, or None to hold it.
+
+    export is negative while importing. Within EXPORT_CONTROL_HYSTERESIS of the
+    limit the setting is held; otherwise it moves by the error in percent of the
+    rated power, rounded away from zero and capped at EXPORT_CONTROL_MAX_STEP.
+    """
+    error = export - limit
+    if abs(error) <= EXPORT_CONTROL_HYSTERESIS:
+        return None
+    step = min(math.ceil(abs(error) * 100 / rated_power), EXPORT_CONTROL_MAX_STEP)
+    target = current - step if error > 0 else current + step
+    target = max(0, min(100, target))
+    return None if target == current else target
+
+
+class ExportLimitController:
+    """Holds the grid export at a limit by adjusting the inverter's feed-in limit.
+
+    While running, the coordinator polls the fast tier every EXPORT_CONTROL_PERIOD
+    and each update with fresh grid power may adjust the feed-in limit register.
+    Adjustments are written in the background and spaced at least
+    EXPORT_CONTROL_MIN_WRITE_INTERVAL apart so the inverter can settle. The
+    feed-in limit is stored in EEPROM, so at most EXPORT_CONTROL_WRITE_BUDGET
+    adjustments are made per EXPORT_CONTROL_BUDGET_WINDOW; once the budget is
+    spent the setting is held until the oldest write leaves the window.
+
+    Only grid power read live on the fast tier of the latest poll is used. The
+    S/T phase registers of three-phase models lie outside the fast blocks, so
+    they are pinned to the fast tier once the model is recognised.
+    """
+
+    def __init__(self, coordinator, api_client, limit: int, rated_power: int):
+        """Initialize the controller for an export limit in watts."""
+        self.coordinator = coordinator
+        self.api_client = api_client
+        self.limit = limit
+        self.rated_power = rated_power
+        self.adjustments = 0
+        self.budget_holds = 0
+        self._writes = deque()  # monotonic times of the adjustments within the budget window
+        self._remove_listener = None
+
+    @property
+    def active(self) -> bool:
+        return self._remove_listener is not None
+
+    def start(self) -> None:
+        """Start fast polling and control."""
+        _LOGGER.info("Holding grid export at %s W (rated power %s W)", self.limit, self.rated_power)
+        self._remove_listener = self.coordinator.async_add_listener(self._async_control)
+        self.coordinator.set_fast_poll_interval(EXPORT_CONTROL_PERIOD)
+
+    def stop(self) -> None:
+        """Stop control; the feed-in limit keeps its last value."""
+        if self._remove_listener is None:
+            return
+        self._remove_listener()
+        self._remove_listener = None
+        self.api_client.unpin_fast_registers(PIN_KEY)
+        self.coordinator.set_fast_poll_interval(None)
+
+    @callback
+    def _async_control(self) -> None:
+        """Adjust the feed-in limit from the grid power of the latest live fast-tier read."""
+        data = self.coordinator.data
+        if not data or self.api_client.data_is_stale or TIER_FAST not in self.api_client.last_poll_live_tiers:
+            return
+        input_regs = self.api_client.last_fast_tier_inputs
+        export_registers, import_registers = grid_power_registers(input_regs)
+        self.api_client.pin_fast_registers(PIN_KEY, export_registers + import_registers)
+        now = time_lib.monotonic()
+        if self._writes and now - self._writes[-1] < EXPORT_CONTROL_MIN_WRITE_INTERVAL:
+            return
+
+        current = data.get("hold", {}).get(H_MAX_BACKFLOW_POWER)
+        # Never mix fresh and cached phases, e.g. right after a three-phase model was recognised
+        if current is None or any(register not in input_regs for register in export_registers + import_registers):
+            return
+
+        export = grid_export_total(input_regs) - grid_import_total(input_regs)
+        target = next_feed_in_percent(current, export, self.limit, self.rated_power)
+        if target is None:
+            return
+
+        while self._writes and now - self._writes[0] >= EXPORT_CONTROL_BUDGET_WINDOW:
+            self._writes.popleft()
+        if len(self._writes) >= EXPORT_CONTROL_WRITE_BUDGET:
+            self.budget_holds += 1
+            if self.budget_holds == 1 or self.budget_holds % EXPORT_CONTROL_WRITE_BUDGET == 0:
+                _LOGGER.warning("Export control write budget (%s per %ss) spent, holding the feed-in limit at %s%%",
+                                EXPORT_CONTROL_WRITE_BUDGET, EXPORT_CONTROL_BUDGET_WINDOW, current)
+            return
+
+        _LOGGER.debug("Grid export %s W (limit %s W): feed-in limit %s%% -> %s%%",
+                      export, self.limit, current, target)
+        self._writes.append(now)
+        self.adjustments += 1
+        self.api_client.submit_write(H_MAX_BACKFLOW_POWER, REGISTER_MASK, target)
@@ -0,0 +1,235 @@
+"""Forced grid charging to a target SOC, run inside the integration."""
+import logging
+from datetime import datetime, timedelta
+
+from homeassistant.core import HomeAssistant, callback
+from homeassistant.exceptions import HomeAssistantError
+from homeassistant.helpers.event import async_call_later
+from homeassistant.helpers.storage import Store
+
+from .const import ATTR_ENTRY_ID, DOMAIN, EVENT_FORCE_CHARGE_FINISHED, FORCE_CHARGE_STORAGE_VERSION, TIER_FAST
+from .constants.hold_registers import (
+    H_AC_CHARGE_BAT_CURRENT,
+    H_AC_CHARGE_END_TIME_2,
+    H_AC_CHARGE_SOC_LIMIT,
+    H_AC_CHARGE_START_TIME_2,
+    H_FUNCTION_ENABLE_1,
+    H_SYSTEM_ENABLE_2,
+)
+from .constants.input_registers import I_SOC_SOH
+from .schedule import compose_time
+from .utils import set_bits
+
+_LOGGER = logging.getLogger(__name__)
+
+AC_CHARGE_TYPE_TIME = 1  # "According to Time" in the AC Charge Type select
+
+REASON_TARGET_REACHED = "target_reached"
+REASON_DEADLINE = "deadline"
+REASON_UNLOADED = "unloaded"
+
+
+def force_charge_store(hass: HomeAssistant, entry_id: str) -> Store:
+    """Return the store holding the interrupted force charge of a config entry."""
+    return Store(hass, FORCE_CHARGE_STORAGE_VERSION, f"{DOMAIN}.{entry_id}.force_charge")
+
+
+def build_charge_settings(start: datetime, duration: int, target_soc: int,
+                          charge_current: int | None = None) -> tuple[dict, dict]:
+    """Return (values, masks) for the hold registers that make the inverter charge from the grid.
+
+    AC charging is enabled by time using time window 2, which runs from start for
+    duration minutes; the AC charge SOC limit stops the inverter itself at the target.
+    """
+    values = {
+        H_FUNCTION_ENABLE_1: set_bits(0, 7, 1, 1),
+        H_SYSTEM_ENABLE_2: set_bits(0, 1, 3, AC_CHARGE_TYPE_TIME),
+        H_AC_CHARGE_SOC_LIMIT: target_soc,
+        H_AC_CHARGE_START_TIME_2: compose_time(start.time()),
+        H_AC_CHARGE_END_TIME_2: compose_time((start + timedelta(minutes=duration)).time()),
+    }
+    masks = {
+        H_FUNCTION_ENABLE_1: set_bits(0, 7, 1, 1),
+        H_SYSTEM_ENABLE_2: set_bits(0, 1, 3, 0b111),
+    }
+    if charge_current is not None:
+        values[H_AC_CHARGE_BAT_CURRENT] = charge_current
+    return values, masks
+
+
+class ForceChargeSession:
+    """One forced charge of an inverter.
+
+    The charge settings are applied as a single register transaction, which also
+    captures the previous values. The session then watches the battery SOC in each
+    coordinator update that read the fast tier live and restores the previous values (only the bits it changed
+    in shared registers) once the target SOC or the deadline is reached.
+
+    The previous values and the deadline are persisted until they have been
+    restored, so a restart in the middle of a charge resumes it (see async_load).
+    """
+
+    def __init__(self, hass: HomeAssistant, entry_id: str, coordinator, api_client,
+                 target_soc: int, duration: int, charge_current: int | None = None):
+        """Initialize the session; nothing is written before async_start."""
+        self._hass = hass
+        self._entry_id = entry_id
+        self._coordinator = coordinator
+        self._api_client = api_client
+        self.target_soc = target_soc
+        self.duration = duration
+        self.charge_current = charge_current
+        self.deadline = None
+        self._masks = {}
+        self._previous = {}
+        self._store = force_charge_store(hass, entry_id)
+        self._unsub_listener = None
+        self._unsub_deadline = None
+        self._finished = False
+
+    @property
+    def soc(self) -> int | None:
+        """Return the battery SOC of the coordinator data, which may be cached or restored from a snapshot."""
+        value = ((self._coordinator.data or {}).get("input") or {}).get(I_SOC_SOH)
+        return None if value is None else value & 0xFF
+
+    @property
+    def active(self) -> bool:
+        return not self._finished
+
+    async def async_start(self, start: datetime) -> dict:
+        """Apply the charge settings and start monitoring. Raises HomeAssistantError if they could not be applied."""
+        values, self._masks = build_charge_settings(start, self.duration, self.target_soc, self.charge_current)
+        result = await self._api_client.async_write_registers(values, self._masks)
+        if not result["success"]:
+            self._finished = True
+            restored = result["rolled_back"]
+            if result["previous"] and not restored:
+                # Some settings may be applied; undo them now, or let the next setup do it
+                self._previous = result["previous"]
+                self.deadline = start
+                await self._store.async_save(self._serialize())
+                restored = (await self._async_restore())["success"]
+            raise HomeAssistantError(
+                f"Could not apply force charge settings (registers {result['failed']})"
+                + (", previous values restored" if restored else "")
+            )
+        self._previous = result["previous"]
+        self.deadline = start + timedelta(minutes=self.duration)
+        await self._store.async_save(self._serialize())
+        self._publish(result["changed"], values)
+
+        _LOGGER.info("Force charge of %s started: target SOC %s%%, at most %s minutes",
+                     self._entry_id, self.target_soc, self.duration)
+        self._monitor(self.duration * 60)
+        return result
+
+    @classmethod
+    async def async_load(cls, hass: HomeAssistant, entry_id: str, coordinator, api_client):
+        """Return the session persisted for an entry, or None if no charge was interrupted."""
+        session = cls(hass, entry_id, coordinator, api_client, 0, 0)
+        stored = await session._store.async_load()
+        if not stored:
+            return None
+        try:
+            session._deserialize(stored)
+        except (KeyError, TypeError, ValueError, AttributeError) as e:
+            _LOGGER.warning("Ignoring unreadable force charge state of %s: %s", entry_id, e)
+            return None
+        return session
+
+    async def async_resume(self, now: datetime) -> None:
+        """Continue a loaded session, or restore the settings right away if its deadline has passed."""
+        remaining = (self.deadline - now).total_seconds()
+        if remaining <= 0:
+            await self.async_stop(REASON_DEADLINE)
+            return
+        _LOGGER.info("Resuming force charge of %s: target SOC %s%%, %.0f minutes left",
+                     self._entry_id, self.target_soc, remaining / 60)
+        self._monitor(remaining)
+        self._async_check_soc()
+
+    def _monitor(self, seconds: float) -> None:
+        self._unsub_listener = self._coordinator.async_add_listener(self._async_check_soc)
+        self._unsub_deadline = async_call_later(self._hass, seconds, self._async_deadline)
+
+    def _serialize(self) -> dict:
+        # JSON turns register numbers into strings
+        return {
+            "target_soc": self.target_soc,
+            "duration": self.duration,
+            "charge_current": self.charge_current,
+            "deadline": self.deadline.isoformat(),
+            "previous": {str(register): value for register, value in self._previous.items()},
+            "masks": {str(register): mask for register, mask in self._masks.items()},
+        }
+
+    def _deserialize(self, stored: dict) -> None:
+        self.target_soc = stored["target_soc"]
+        self.duration = stored["duration"]
+        self.charge_current = stored.get("charge_current")
+        self.deadline = datetime.fromisoformat(stored["deadline"])
+        self._previous = {int(register): value for register, value in stored["previous"].items()}
+        self._masks = {int(register): mask for register, mask in stored["masks"].items()}
+
+    @callback
+    def _async_check_soc(self) -> None:
+        # Only a live fast-tier read may end the charge, not a cached or restored SOC
+        if self._api_client.data_is_stale or TIER_FAST not in self._api_client.last_poll_live_tiers:
+            return
+        soc = self.soc
+        if self.active and soc is not None and soc >= self.target_soc:
+            self._hass.async_create_task(self.async_stop(REASON_TARGET_REACHED))
+
+    @callback
+    def _async_deadline(self, _now) -> None:
+        self._unsub_deadline = None
+        if self.active:
+            self._hass.async_create_task(self.async_stop(REASON_DEADLINE))
+
+    async def async_stop(self, reason: str) -> bool:
+        """Restore the previous settings and report the outcome. Returns True if they were restored."""
+        if self._finished:
+            return False
+        self._finished = True
+        if self._unsub_listener:
+            self._unsub_listener()
+            self._unsub_listener = None
+        if self._unsub_deadline:
+            self._unsub_deadline()
+            self._unsub_deadline = None
+
+        result = await self._async_restore()
+        restored = result["success"]
+        if restored:
+            _LOGGER.info("Force charge of %s finished (%s), settings restored", self._entry_id, reason)
+        else:
+            _LOGGER.error("Force charge of %s finished (%s), but restoring registers %s failed",
+                          self._entry_id, reason, result["failed"])
+
+        self._hass.bus.async_fire(EVENT_FORCE_CHARGE_FINISHED, {
+            ATTR_ENTRY_ID: self._entry_id,
+            "reason": reason,
+            "soc": self.soc,
+            "restored": restored,
+        })
+        return restored
+
+    async def _async_restore(self) -> dict:
+        """Write back the previous values, only the changed bits of shared registers, and return the result."""
+        result = await self._api_client.async_write_registers(
+            self._previous, {register: mask for register, mask in self._masks.items() if register in self._previous})
+        if result["success"]:
+            # Without a restore the state stays persisted and the next setup retries it
+            await self._store.async_remove()
+            self._publish(result["changed"], self._previous)
+        return result
+
+    def _publish(self, changed: list[int], values: dict) -> None:
+        """Show the written values in the entities without waiting for the next poll."""
+        if self._coordinator.data is None or not changed:
+            return
+        hold = self._coordinator.data.setdefault("hold", {})
+        for register in changed:
+            hold[register] = self._api_client.cached_data["hold"].get(register, values[register])
+        self._coordinator.async_update_listeners()
@@ -0,0 +1,153 @@
+"""Parallel groups: inverters of one parallel system polled in aligned cycles."""
+import asyncio
+import logging
+import math
+import time as time_lib
+
+from homeassistant.core import callback
+
+from .const import GROUP_ALIGN_TOLERANCE, GROUP_READ_WINDOW, GROUP_STALE_CYCLES
+
+_LOGGER = logging.getLogger(__name__)
+
+PIN_KEY = "parallel_group"
+
+
+class ParallelGroup:
+    """The config entries of one parallel system, polled on shared cycle boundaries.
+
+    Members poll at the start of every cycle of the group period (the shortest
+    member poll interval), so their fast tiers are read within a tight window.
+    Each poll whose fast tier was read within GROUP_READ_WINDOW of a cycle start
+    is recorded as a snapshot of the fast-tier registers, tagged with that cycle;
+    a read delayed by the dongle lock or the I/O scheduler is dropped. A cycle is
+    complete once every member has a snapshot of it, and only complete cycles are
+    handed to the cycle listeners. Cross-inverter values therefore never mix data
+    from different cycles.
+
+    The registers the group's values depend on are pinned to each member's fast
+    tier. The group's entities are hosted by one member at a time; when the host
+    unloads, the next member that offered to host them creates them again.
+    """
+
+    def __init__(self, name: str, registers=(), clock=time_lib.monotonic):
+        """Initialize an empty group whose values depend on the given input registers."""
+        self.name = name
+        self._registers = frozenset(registers)
+        self._clock = clock
+        self._members = {}  # entry_id -> coordinator
+        self._snapshots = {}  # entry_id -> (cycle id, input registers)
+        self._complete = {}  # entry_id -> input registers of the last complete cycle
+        self._listeners = []
+        self._entity_hosts = {}  # entry_id -> callback creating the group's entities on that entry
+        self.entity_host = None
+        self.completed_cycle = None
+        self.completed_at = None
+        self.incomplete_cycles = 0
+
+    @property
+    def members(self) -> dict:
+        return self._members
+
+    @property
+    def is_current(self) -> bool:
+        """Return True while the last complete cycle is at most GROUP_STALE_CYCLES periods old."""
+        return self.completed_at is not None and (
+            self._clock() - self.completed_at <= GROUP_STALE_CYCLES * self.period)
+
+    @property
+    def period(self) -> float:
+        """Length of a cycle: the shortest poll interval of the members."""
+        return min((c.poll_interval for c in self._members.values()), default=0)
+
+    def add_member(self, entry_id: str, coordinator) -> None:
+        self._members[entry_id] = coordinator
+        coordinator.api_client.pin_fast_registers(PIN_KEY, self._registers)
+        _LOGGER.info("Parallel group '%s' has %s member(s)", self.name, len(self._members))
+
+    def remove_member(self, entry_id: str) -> None:
+        coordinator = self._members.pop(entry_id, None)
+        if coordinator is not None:
+            coordinator.api_client.unpin_fast_registers(PIN_KEY)
+        self._snapshots.pop(entry_id, None)
+        self._complete.pop(entry_id, None)
+        self._entity_hosts.pop(entry_id, None)
+        if self.entity_host == entry_id:
+            self.entity_host = None
+            self._assign_entity_host()
+
+    @callback
+    def async_offer_entity_host(self, entry_id: str, create_entities) -> None:
+        """Let a member host the group's entities; create_entities() is called once it becomes the host."""
+        self._entity_hosts[entry_id] = create_entities
+        if self.entity_host is None:
+            self._assign_entity_host()
+
+    def _assign_entity_host(self) -> None:
+        self.entity_host = next(iter(self._entity_hosts), None)
+        if self.entity_host is not None:
+            _LOGGER.info("Parallel group '%s' entities are provided by %s", self.name, self.entity_host)
+            self._entity_hosts[self.entity_host]()
+
+    def seconds_to_next_cycle(self) -> float:
+        """Return the time until the next cycle boundary."""
+        period = self.period
+        return period - (self._clock() % period) if period else 0
+
+    def cycle_of_read(self, moment: float) -> int | None:
+        """Return the id of the cycle whose read window contains moment, or None if the read was too late."""
+        period = self.period
+        if not period:
+            return None
+        # A poll timer may fire slightly before the boundary
+        cycle = math.floor((moment + GROUP_ALIGN_TOLERANCE) / period)
+        return cycle if moment - cycle * period <= min(GROUP_READ_WINDOW, period / 2) else None
+
+    def record(self, entry_id: str, cycle: int, input_regs: dict) -> None:
+        """Store a member's fast-tier snapshot of a cycle and notify listeners once the cycle is complete."""
+        if entry_id not in self._members:
+            return
+        latest = max((c for c, _ in self._snapshots.values()), default=None)
+        if latest is not None and cycle > latest and latest != self.completed_cycle:
+            # A member missed the previous cycle (failed or late poll)
+            self.incomplete_cycles += 1
+        self._snapshots[entry_id] = (cycle, dict(input_regs))
+
+        if len(self._snapshots) == len(self._members) and all(
+                c == cycle for c, _ in self._snapshots.values()) and self.completed_cycle != cycle:
+            self.completed_cycle = cycle
+            self.completed_at = self._clock()
+            self._complete = {member: regs for member, (_, regs) in self._snapshots.items()}
+            for listener in list(self._listeners):
+                listener()
+
+    def snapshots(self) -> dict[str, dict]:
+        """Return the input registers of every member for the last complete cycle."""
+        return dict(self._complete)
+
+    async def async_broadcast_write(self, values: dict[int, int], masks: dict[int, int] | None = None) -> dict:
+        """Apply the same register transaction to every member concurrently.
+
+        Each member writes over its own dongle session (see
+        LxpModbusApiClient.async_write_registers). Returns {entry_id: result};
+        a member whose transaction raised reports it as a failed result.
+        """
+        entry_ids = list(self._members)
+        outcomes = await asyncio.gather(
+            *(self._members[entry_id].api_client.async_write_registers(values, masks) for entry_id in entry_ids),
+            return_exceptions=True,
+        )
+        results = {}
+        for entry_id, outcome in zip(entry_ids, outcomes):
+            if isinstance(outcome, Exception):
+                _LOGGER.error("Group '%s' write to %s raised: %s", self.name, entry_id, outcome)
+                outcome = {"success": False, "changed": [], "unchanged": [], "failed": sorted(values),
+                           "rolled_back": False, "previous": {}}
+            results[entry_id] = outcome
+        return results
+
+    @callback
+    def async_add_listener(self, update_callback):
+        """Call update_callback after each complete cycle; returns a function removing it."""
+        self._listeners.append(update_callback)
+        return lambda: self._listeners.remove(update_callback)
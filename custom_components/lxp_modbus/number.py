@@ -3,6 +3,7 @@ import logging
 from homeassistant.components.number import NumberEntity, NumberMode
 from homeassistant.helpers.update_coordinator import DataUpdateCoordinator
 
+from .classes.bitfield_writer import REGISTER_MASK, compose_to_mask
 from .const import DOMAIN, CONF_ENTITY_PREFIX, DEFAULT_ENTITY_PREFIX
 from .entity import ModbusBridgeEntity
 from .entity_descriptions.number_types import NUMBER_TYPES
@@ -68,20 +69,21 @@ class ModbusBridgeNumber(ModbusBridgeEntity, NumberEntity):
         # Scale the UI value up to the raw integer value for writing to the register
         value_to_write = int(value * self._multiplier)
 
-        # Apply compose function if defined (for handling signed values, bit manipulation, etc.)
-        if self._compose_fn:
-            # Get current register value for compose function
-            current_value = self.coordinator.data.get(self._register_type, {}).get(self._register, 0)
-            value_to_write = self._compose_fn(current_value, value_to_write)
-
         if not self._api_client:
             _LOGGER.error("API client not found, cannot write to number '%s'", self.name)
             return
 
-        # Call the write method on the API client
-        success = await self._api_client.async_write_register(self._register, value_to_write)
-        
-        if success:
-            # Optimistically update the coordinator's data and refresh the entity
-            self.coordinator.data[self._register_type][self._register] = value_to_write
-            self.async_write_ha_state()
\ No newline at end of file
+        # Apply compose function if defined (for handling signed values, bit manipulation, etc.).
+        # Only the bits it owns are written; the rest of the register is read fresh.
+        if self._compose_fn:
+            mask, bits = compose_to_mask(self._compose_fn, value_to_write)
+        else:
+            mask, bits = REGISTER_MASK, value_to_write
+
+        # Values set in quick succession (slider drags, automations ramping a
+        # value) are coalesced so only the latest target is written
+        new_register_value = self._api_client.submit_write(self._register, mask, bits, debounce=True)
+
+        # Show the value right away; it reverts if the inverter does not confirm it
+        self.coordinator.data[self._register_type][self._register] = new_register_value
+        self.async_write_ha_state()
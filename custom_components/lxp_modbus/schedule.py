@@ -0,0 +1,76 @@
+"""Daily time-slot schedules written as whole register ranges."""
+from datetime import time
+
+from .classes.data_validator import is_time_value_sane
+from .constants.hold_registers import (
+    H_AC_CHARGE_START_TIME, H_AC_CHARGE_END_TIME, H_AC_CHARGE_START_TIME_1, H_AC_CHARGE_END_TIME_1,
+    H_AC_CHARGE_START_TIME_2, H_AC_CHARGE_END_TIME_2,
+    H_FORCED_DISCHARGE_START_TIME, H_FORCED_DISCHARGE_END_TIME, H_FORCED_DISCHARGE_START_TIME_1,
+    H_FORCED_DISCHARGE_END_TIME_1, H_FORCED_DISCHARGE_START_TIME_2, H_FORCED_DISCHARGE_END_TIME_2,
+    H_AC_FIRST_START_TIME, H_AC_FIRST_END_TIME, H_AC_FIRST_START_TIME_1, H_AC_FIRST_END_TIME_1,
+    H_AC_FIRST_START_TIME_2, H_AC_FIRST_END_TIME_2,
+    H_PEAK_SHAVING_START_TIME, H_PEAK_SHAVING_END_TIME, H_PEAK_SHAVING_START_TIME_1, H_PEAK_SHAVING_END_TIME_1,
+    H_GEN_START_TIME, H_GEN_END_TIME, H_GEN_START_TIME_1, H_GEN_END_TIME_1,
+)
+
+ATTR_START = "start"
+ATTR_END = "end"
+
+# (start register, end register) of each time slot, in the order of the time entities
+SCHEDULE_FUNCTIONS = {
+    "ac_charge": (
+        (H_AC_CHARGE_START_TIME, H_AC_CHARGE_END_TIME),
+        (H_AC_CHARGE_START_TIME_1, H_AC_CHARGE_END_TIME_1),
+        (H_AC_CHARGE_START_TIME_2, H_AC_CHARGE_END_TIME_2),
+    ),
+    "forced_discharge": (
+        (H_FORCED_DISCHARGE_START_TIME, H_FORCED_DISCHARGE_END_TIME),
+        (H_FORCED_DISCHARGE_START_TIME_1, H_FORCED_DISCHARGE_END_TIME_1),
+        (H_FORCED_DISCHARGE_START_TIME_2, H_FORCED_DISCHARGE_END_TIME_2),
+    ),
+    "ac_first": (
+        (H_AC_FIRST_START_TIME, H_AC_FIRST_END_TIME),
+        (H_AC_FIRST_START_TIME_1, H_AC_FIRST_END_TIME_1),
+        (H_AC_FIRST_START_TIME_2, H_AC_FIRST_END_TIME_2),
+    ),
+    "peak_shaving": (
+        (H_PEAK_SHAVING_START_TIME, H_PEAK_SHAVING_END_TIME),
+        (H_PEAK_SHAVING_START_TIME_1, H_PEAK_SHAVING_END_TIME_1),
+    ),
+    "generator": (
+        (H_GEN_START_TIME, H_GEN_END_TIME),
+        (H_GEN_START_TIME_1, H_GEN_END_TIME_1),
+    ),
+}
+
+
+def compose_time(moment: time) -> int:
+    """Pack a time of day as the time entities do: Hour | (Minute << 8)."""
+    return (moment.hour & 0xFF) | ((moment.minute & 0xFF) << 8)
+
+
+def build_schedule_registers(schedule: dict) -> dict[int, int]:
+    """Return the hold register values for a schedule of {function: [{start, end}, ...]}.
+
+    Every slot of a listed function is written: windows fill the slots in order
+    and the remaining slots are cleared to 00:00-00:00. Functions that are not
+    listed keep their current slots. Raises ValueError for an unknown function,
+    too many windows or a time that fails the register sanity check.
+    """
+    values = {}
+    for function, windows in schedule.items():
+        slots = SCHEDULE_FUNCTIONS.get(function)
+        if slots is None:
+            raise ValueError(f"Unknown schedule function '{function}'")
+        if len(windows) > len(slots):
+            raise ValueError(f"'{function}' has {len(slots)} time slots, {len(windows)} windows given")
+
+        for index, (start_register, end_register) in enumerate(slots):
+            window = windows[index] if index < len(windows) else None
+            start = compose_time(window[ATTR_START]) if window else 0
+            end = compose_time(window[ATTR_END]) if window else 0
+            for register, value in ((start_register, start), (end_register, end)):
+                if not is_time_value_sane(value):
+                    raise ValueError(f"Invalid time for '{function}' slot {index + 1}")
+                values[register] = value
+    return values
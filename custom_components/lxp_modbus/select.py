@@ -3,6 +3,7 @@ import logging
 from homeassistant.components.select import SelectEntity
 from homeassistant.helpers.update_coordinator import DataUpdateCoordinator
 
+from .classes.bitfield_writer import compose_to_mask
 from .const import DOMAIN, CONF_ENTITY_PREFIX, DEFAULT_ENTITY_PREFIX
 from .entity import ModbusBridgeEntity
 from .entity_descriptions.selectbox_types import SELECTBOX_TYPES
@@ -58,16 +59,11 @@ class ModbusBridgeSelect(ModbusBridgeEntity, SelectEntity):
             _LOGGER.error("API client not found, cannot write to select '%s'", self.name)
             return
             
-        # Get the current value of the entire register to modify it
-        original_register_value = self.coordinator.data.get(self._register_type, {}).get(self._register, 0)
+        # Write only the option's bits; the rest of the register is read fresh
+        # from the inverter and concurrent changes to it are batched
+        mask, bits = compose_to_mask(self._compose, index)
+        new_register_value = self._api_client.submit_write(self._register, mask, bits)
 
-        # Use the compose function to create the new register value
-        new_register_value = self._compose(original_register_value, index)
-
-        # Call the write method on the API client
-        success = await self._api_client.async_write_register(self._register, new_register_value)
-        
-        if success:
-            # Optimistically update the coordinator's data and refresh the entity
-            self.coordinator.data[self._register_type][self._register] = new_register_value
-            self.async_write_ha_state()
\ No newline at end of file
+        # Show the option right away; it reverts if the inverter does not confirm it
+        self.coordinator.data[self._register_type][self._register] = new_register_value
+        self.async_write_ha_state()
\ No newline at end of file
@@ -2,6 +2,7 @@ import logging
 from datetime import time as dt_time
 
 from homeassistant.components.sensor import SensorEntity
+from homeassistant.core import callback
 from homeassistant.helpers.update_coordinator import DataUpdateCoordinator
 
 from homeassistant.const import Platform
@@ -14,9 +15,12 @@ from .const import (
     DEFAULT_READ_ONLY,
     DEFAULT_ENTITY_PREFIX,
     DEFAULT_BATTERY_ENTITIES,
+    INTEGRATION_TITLE,
 )
 from .entity import ModbusBridgeEntity
-from .entity_descriptions.sensor_types import SENSOR_TYPES, BATTERY_SENSOR_TYPES
+from .entity_descriptions.sensor_types import (
+    SENSOR_TYPES, BATTERY_SENSOR_TYPES, DIAGNOSTIC_SENSOR_TYPES, GROUP_SENSOR_TYPES,
+)
 from .entity_descriptions.number_types import NUMBER_TYPES
 from .entity_descriptions.selectbox_types import SELECTBOX_TYPES
 from .entity_descriptions.switch_types import SWITCH_TYPES
@@ -41,6 +45,10 @@ async def async_setup_entry(hass, entry, async_add_entities):
         ModbusBridgeSensor(coordinator, entry, desc, entity_prefix, api_client)
         for desc in SENSOR_TYPES
     ]
+    entities.extend(
+        ModbusBridgeDiagnosticSensor(coordinator, entry, desc, entity_prefix, api_client)
+        for desc in DIAGNOSTIC_SENSOR_TYPES
+    )
 
     # If in read-only mode, create read-only sensors for all the control types
     if is_read_only:
@@ -58,13 +66,19 @@ async def async_setup_entry(hass, entry, async_add_entities):
             for desc in descriptions:
                 entities.append(ModbusBridgeReadOnlySensor(coordinator, entry, desc, entity_prefix, platform))
 
+    # System totals of a parallel group are provided by one member at a time;
+    # another member takes over when it unloads
+    group = hass.data[DOMAIN][entry.entry_id].get("group")
+    if group is not None:
+        group.async_offer_entity_host(entry.entry_id, lambda: async_add_entities(
+            [ModbusBridgeGroupSensor(group, entry, coordinator, desc) for desc in GROUP_SENSOR_TYPES]))
+
     # --- Battery entity setup ---
-    known_batteries = set()
+    battery_sensors = {}  # serial -> entities of that pack
 
     def _create_battery_sensors(serial):
         """Create battery sensor entities for a given battery serial."""
-        known_batteries.add(serial)
-        bat_entities = []
+        bat_entities = battery_sensors[serial] = []
         for generic_desc in BATTERY_SENSOR_TYPES:
             desc = dict(generic_desc)
             desc["device_group"] = f"Battery {serial}"
@@ -74,27 +88,39 @@ async def async_setup_entry(hass, entry, async_add_entities):
         _LOGGER.info("Creating %d battery entities for %s", len(bat_entities), serial)
         return bat_entities
 
-    def _check_for_new_batteries():
-        """Coordinator listener: auto-discover new batteries."""
-        battery = coordinator.data.get("battery", {})
-        for serial in battery:
-            if serial not in known_batteries:
-                async_add_entities(_create_battery_sensors(serial))
-            _LOGGER.debug("Battery info: %s %s", serial, battery[serial])
+    configured_batteries = battery_entities_cfg - {'auto', 'none'}
+
+    @callback
+    def _async_batteries_changed(added, removed):
+        """Battery listener: add entities for new packs, remove those of discovered packs that are gone."""
+        new_entities = []
+        for serial in sorted(added):
+            if serial not in battery_sensors:
+                new_entities.extend(_create_battery_sensors(serial))
+        if new_entities:
+            async_add_entities(new_entities)
+        for serial in removed:
+            # Configured packs stay and go unavailable; registry entries are kept for a re-added pack
+            if serial in configured_batteries:
+                continue
+            for entity in battery_sensors.pop(serial, []):
+                hass.async_create_task(entity.async_remove())
+            _LOGGER.info("Removed battery entities for %s", serial)
 
     # Create entities for explicitly configured battery serials
-    for serial in battery_entities_cfg:
-        if serial not in ('auto', 'none'):
-            entities.extend(_create_battery_sensors(serial))
-
-    async_add_entities(entities)
+    for serial in configured_batteries:
+        entities.extend(_create_battery_sensors(serial))
 
-    # If auto-discovery is enabled, register a coordinator listener
+    # If auto-discovery is enabled, packs known from the persisted snapshot get their
+    # entities right away; the battery decoder reports packs that appear or disappear later
     if 'auto' in battery_entities_cfg:
         _LOGGER.info("Battery auto-discovery enabled")
-        entry.async_on_unload(
-            coordinator.async_add_listener(_check_for_new_batteries)
-        )
+        for serial in sorted(coordinator.data.get("battery", {}) if coordinator.data else ()):
+            if serial not in battery_sensors:
+                entities.extend(_create_battery_sensors(serial))
+        entry.async_on_unload(coordinator.async_add_battery_listener(_async_batteries_changed))
+
+    async_add_entities(entities)
 
 class ModbusBridgeSensor(ModbusBridgeEntity, SensorEntity):
     """Represents a standard sensor entity that gets its data from the coordinator."""
@@ -178,6 +204,109 @@ class ModbusBridgeBatterySensor(ModbusBridgeSensor):
         self._battery_serial = battery_serial
         super().__init__(coordinator, entry, desc, entity_prefix, api_client)
 
+    @property
+    def available(self) -> bool:
+        """A pack goes unavailable only when its own data has expired, not with a failed inverter poll."""
+        return self._api_client.battery_is_fresh(self._battery_serial)
+
+
+class ModbusBridgeDiagnosticSensor(ModbusBridgeSensor):
+    """Represents a diagnostic sensor reporting the runtime state of the API client."""
+
+    @property
+    def available(self) -> bool:
+        """Diagnostic sensors stay available while the inverter is unreachable."""
+        return self._api_client is not None
+
+    @property
+    def native_value(self):
+        """Return the diagnostic value extracted from the client's runtime state."""
+        return self._desc["extract"](self._api_client.get_diagnostics())
+
+
+class ModbusBridgeGroupSensor(SensorEntity):
+    """Represents a system total computed across the members of a parallel group.
+
+    The value is computed once per complete group cycle, from the snapshots
+    of that cycle only, and the state is written only when one of the
+    registers it depends on changed. The host's polls re-check availability,
+    so the value goes unavailable once the group stops completing cycles.
+    """
+
+    _attr_should_poll = False
+
+    def __init__(self, group, entry, coordinator, desc: dict):
+        """Initialize the group sensor."""
+        self._group = group
+        self._entry = entry
+        self._coordinator = coordinator
+        self._available = False
+        self._desc = desc
+        self._inputs = None
+        self._value = None
+
+        self._attr_name = f"{group.name} {desc['name']}"
+        self._attr_unique_id = f"group_{group.name}_{desc['key']}"
+        self._attr_device_class = desc.get("device_class")
+        self._attr_native_unit_of_measurement = desc.get("unit")
+        self._attr_state_class = desc.get("state_class")
+        self._attr_icon = desc.get("icon")
+        self._attr_device_info = {
+            "identifiers": {(DOMAIN, f"group_{group.name}")},
+            "name": f"{INTEGRATION_TITLE} Parallel Group {group.name}",
+            "manufacturer": "LuxpowerTek",
+            "model": "Parallel System",
+        }
+
+    async def async_added_to_hass(self) -> None:
+        """Follow the group's complete cycles and the host's polls."""
+        self.async_on_remove(self._group.async_add_listener(self._handle_cycle))
+        self.async_on_remove(self._coordinator.async_add_listener(self._handle_poll))
+        self._update_value()
+        self._available = self._group.is_current
+
+    @callback
+    def _handle_cycle(self) -> None:
+        was_available, self._available = self._available, True
+        if self._update_value() or not was_available:
+            self.async_write_ha_state()
+
+    @callback
+    def _handle_poll(self) -> None:
+        if self._group.is_current != self._available:
+            self._available = not self._available
+            self.async_write_ha_state()
+
+    def _update_value(self) -> bool:
+        """Recompute the value if its inputs changed. Returns True if they did."""
+        members = self._group.snapshots()
+        inputs = tuple(
+            (entry_id, tuple(regs.get(register) for register in self._desc["depends_on"]))
+            for entry_id, regs in sorted(members.items())
+        )
+        if inputs == self._inputs:
+            return False
+        self._inputs = inputs
+        self._value = self._desc["extract"](members, self._entry) if members else None
+        return True
+
+    @property
+    def available(self) -> bool:
+        return self._available
+
+    @property
+    def native_value(self):
+        return self._value
+
+    @property
+    def extra_state_attributes(self):
+        return {
+            "cycle": self._group.completed_cycle,
+            "members": len(self._group.members),
+            "incomplete_cycles": self._group.incomplete_cycles,
+            "dependencies": self._desc["depends_on"],
+        }
+
 
 def _render_number_value(register_value, desc):
     """Render a number entity value for read-only display."""
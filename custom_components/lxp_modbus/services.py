@@ -0,0 +1,277 @@
+"""Services for the LuxPower Modbus integration."""
+import logging
+
+import voluptuous as vol
+
+from homeassistant.core import HomeAssistant, ServiceCall, SupportsResponse
+from homeassistant.exceptions import HomeAssistantError, ServiceValidationError
+import homeassistant.helpers.config_validation as cv
+from homeassistant.util import dt as dt_util
+
+from .const import (
+    DOMAIN,
+    CONF_READ_ONLY,
+    DEFAULT_READ_ONLY,
+    DATA_GROUPS,
+    EVENT_GROUP_WRITE,
+    EVENT_PROFILE_APPLIED,
+    FORCE_CHARGE_MAX_DURATION,
+    TOTAL_REGISTERS,
+    SERVICE_APPLY_PROFILE,
+    SERVICE_FORCE_CHARGE,
+    SERVICE_SET_SCHEDULE,
+    SERVICE_GROUP_WRITE,
+    SERVICE_DUMP_FRAMES,
+    ATTR_ENTRY_ID,
+    ATTR_GROUP,
+    ATTR_PROFILE,
+    ATTR_REGISTERS,
+    ATTR_TARGET_SOC,
+    ATTR_DURATION,
+    ATTR_CHARGE_CURRENT,
+)
+from .force_charge import ForceChargeSession
+from .schedule import ATTR_END, ATTR_START, SCHEDULE_FUNCTIONS, build_schedule_registers
+
+_LOGGER = logging.getLogger(__name__)
+
+# Hold register number -> raw value, for register transactions
+REGISTER_VALUES = vol.All(
+    {
+        vol.All(vol.Coerce(int), vol.Range(min=0, max=TOTAL_REGISTERS - 1)):
+            vol.All(vol.Coerce(int), vol.Range(min=0, max=0xFFFF)),
+    },
+    vol.Length(min=1),
+)
+
+APPLY_PROFILE_SCHEMA = vol.Schema({
+    vol.Required(ATTR_ENTRY_ID): cv.string,
+    vol.Optional(ATTR_PROFILE, default=""): cv.string,
+    vol.Required(ATTR_REGISTERS): REGISTER_VALUES,
+})
+
+FORCE_CHARGE_SCHEMA = vol.Schema({
+    vol.Required(ATTR_ENTRY_ID): cv.string,
+    vol.Required(ATTR_TARGET_SOC): vol.All(vol.Coerce(int), vol.Range(min=1, max=100)),
+    vol.Required(ATTR_DURATION): vol.All(vol.Coerce(int), vol.Range(min=1, max=FORCE_CHARGE_MAX_DURATION)),
+    vol.Optional(ATTR_CHARGE_CURRENT): vol.All(vol.Coerce(int), vol.Range(min=0, max=140)),
+})
+
+GROUP_WRITE_SCHEMA = vol.Schema({
+    vol.Required(ATTR_GROUP): cv.string,
+    vol.Required(ATTR_REGISTERS): REGISTER_VALUES,
+})
+
+DUMP_FRAMES_SCHEMA = vol.Schema({
+    vol.Required(ATTR_ENTRY_ID): cv.string,
+})
+
+SCHEDULE_WINDOW_SCHEMA = vol.Schema({
+    vol.Required(ATTR_START): cv.time,
+    vol.Required(ATTR_END): cv.time,
+})
+
+SET_SCHEDULE_SCHEMA = vol.Schema({
+    vol.Required(ATTR_ENTRY_ID): cv.string,
+    **{
+        vol.Optional(function): vol.All(cv.ensure_list, [SCHEDULE_WINDOW_SCHEMA])
+        for function in SCHEDULE_FUNCTIONS
+    },
+})
+
+
+def get_entry_data(hass: HomeAssistant, entry_id: str) -> dict:
+    """Return the runtime data of a loaded config entry or raise ServiceValidationError."""
+    entry_data = hass.data.get(DOMAIN, {}).get(entry_id)
+    if not isinstance(entry_data, dict) or "coordinator" not in entry_data:
+        raise ServiceValidationError(f"No loaded LuxPower inverter with config entry id {entry_id}")
+    return entry_data
+
+
+def get_writable_entry_data(hass: HomeAssistant, entry_id: str) -> dict:
+    """Return the runtime data of a loaded, writable config entry or raise ServiceValidationError."""
+    entry_data = get_entry_data(hass, entry_id)
+    if entry_data["settings"].get(CONF_READ_ONLY, DEFAULT_READ_ONLY):
+        raise ServiceValidationError(f"LuxPower inverter {entry_id} is configured as read-only")
+    return entry_data
+
+
+async def _async_publish_result(entry_data: dict, result: dict, targets: dict) -> None:
+    """Show the outcome of a register transaction in the entities."""
+    coordinator = entry_data["coordinator"]
+    if result["success"]:
+        if coordinator.data is not None and result["changed"]:
+            hold = coordinator.data.setdefault("hold", {})
+            for register in result["changed"]:
+                hold[register] = targets[register]
+            coordinator.async_update_listeners()
+    else:
+        # Partially applied or rolled back: let a poll show what the inverter really holds
+        await coordinator.async_request_refresh()
+
+
+async def _async_apply_profile(hass: HomeAssistant, call: ServiceCall) -> dict:
+    """Write a set of hold register values as one transaction and report the outcome as an event."""
+    entry_id = call.data[ATTR_ENTRY_ID]
+    entry_data = get_writable_entry_data(hass, entry_id)
+    profile = call.data[ATTR_PROFILE]
+    targets = call.data[ATTR_REGISTERS]
+
+    _LOGGER.info("Applying profile '%s' (%s registers) to %s", profile, len(targets), entry_id)
+    result = await entry_data["api_client"].async_write_registers(targets)
+
+    await _async_publish_result(entry_data, result, targets)
+
+    event_data = {ATTR_ENTRY_ID: entry_id, ATTR_PROFILE: profile, **result}
+    hass.bus.async_fire(EVENT_PROFILE_APPLIED, event_data)
+
+    if not result["success"]:
+        raise HomeAssistantError(
+            f"Profile '{profile}' failed for registers {result['failed']}"
+            + (", previous values restored" if result["rolled_back"] else "")
+        )
+    return event_data
+
+
+async def _async_force_charge(hass: HomeAssistant, call: ServiceCall) -> dict:
+    """Charge from the grid until the target SOC or the duration is reached, then restore the settings."""
+    entry_id = call.data[ATTR_ENTRY_ID]
+    entry_data = get_writable_entry_data(hass, entry_id)
+
+    running = entry_data.get("force_charge")
+    if running is not None and running.active:
+        raise ServiceValidationError(f"A force charge of {entry_id} is already running")
+
+    session = ForceChargeSession(
+        hass, entry_id, entry_data["coordinator"], entry_data["api_client"],
+        call.data[ATTR_TARGET_SOC], call.data[ATTR_DURATION], call.data.get(ATTR_CHARGE_CURRENT),
+    )
+    if session.soc is not None and session.soc >= session.target_soc:
+        raise ServiceValidationError(f"Battery SOC is already {session.soc}%, at or above the target")
+
+    entry_data["force_charge"] = session
+    result = await session.async_start(dt_util.now())
+    return {
+        ATTR_ENTRY_ID: entry_id,
+        ATTR_TARGET_SOC: session.target_soc,
+        ATTR_DURATION: session.duration,
+        "changed": result["changed"],
+    }
+
+
+async def _async_set_schedule(hass: HomeAssistant, call: ServiceCall) -> dict:
+    """Write the time slots of one or more functions in a single register transaction."""
+    entry_id = call.data[ATTR_ENTRY_ID]
+    entry_data = get_writable_entry_data(hass, entry_id)
+    schedule = {function: call.data[function] for function in SCHEDULE_FUNCTIONS if function in call.data}
+    if not schedule:
+        raise ServiceValidationError("No schedule given")
+    try:
+        targets = build_schedule_registers(schedule)
+    except ValueError as err:
+        raise ServiceValidationError(str(err)) from err
+
+    result = await entry_data["api_client"].async_write_registers(targets)
+    await _async_publish_result(entry_data, result, targets)
+    if not result["success"]:
+        raise HomeAssistantError(
+            f"Schedule update failed for registers {result['failed']}"
+            + (", previous values restored" if result["rolled_back"] else "")
+        )
+    return {ATTR_ENTRY_ID: entry_id, "changed": result["changed"], "unchanged": result["unchanged"]}
+
+
+async def _async_group_write(hass: HomeAssistant, call: ServiceCall) -> dict:
+    """Write the same registers to every member of a parallel group and report all outcomes together."""
+    name = call.data[ATTR_GROUP]
+    group = hass.data.get(DOMAIN, {}).get(DATA_GROUPS, {}).get(name)
+    if group is None or not group.members:
+        raise ServiceValidationError(f"No loaded parallel group named '{name}'")
+    # Every member must be writable, otherwise the group would end up inconsistent
+    members = {entry_id: get_writable_entry_data(hass, entry_id) for entry_id in group.members}
+    targets = call.data[ATTR_REGISTERS]
+
+    _LOGGER.info("Writing %s registers to the %s members of group '%s'", len(targets), len(members), name)
+    results = await group.async_broadcast_write(targets)
+    for entry_id, result in results.items():
+        await _async_publish_result(members[entry_id], result, targets)
+
+    failed = sorted(entry_id for entry_id, result in results.items() if not result["success"])
+    event_data = {ATTR_GROUP: name, "success": not failed, "failed_members": failed, "members": results}
+    hass.bus.async_fire(EVENT_GROUP_WRITE, event_data)
+
+    if failed:
+        details = "; ".join(
+            f"{members[entry_id]['coordinator'].name}: registers {results[entry_id]['failed']}"
+            + (" (restored)" if results[entry_id]["rolled_back"] else "")
+            for entry_id in failed
+        )
+        raise HomeAssistantError(
+            f"Group '{name}' write failed on {len(failed)} of {len(results)} members: {details}")
+    return event_data
+
+
+async def _async_dump_frames(hass: HomeAssistant, call: ServiceCall) -> dict:
+    """Return the recent raw frames exchanged with the inverter's dongle, oldest first."""
+    entry_id = call.data[ATTR_ENTRY_ID]
+    entry_data = get_entry_data(hass, entry_id)
+    return {ATTR_ENTRY_ID: entry_id, "frames": entry_data["api_client"].frame_trace.dump()}
+
+
+def async_setup_services(hass: HomeAssistant) -> None:
+    """Register the integration's services."""
+
+    async def handle_apply_profile(call: ServiceCall) -> dict:
+        return await _async_apply_profile(hass, call)
+
+    hass.services.async_register(
+        DOMAIN,
+        SERVICE_APPLY_PROFILE,
+        handle_apply_profile,
+        schema=APPLY_PROFILE_SCHEMA,
+        supports_response=SupportsResponse.OPTIONAL,
+    )
+
+    async def handle_force_charge(call: ServiceCall) -> dict:
+        return await _async_force_charge(hass, call)
+
+    hass.services.async_register(
+        DOMAIN,
+        SERVICE_FORCE_CHARGE,
+        handle_force_charge,
+        schema=FORCE_CHARGE_SCHEMA,
+        supports_response=SupportsResponse.OPTIONAL,
+    )
+
+    async def handle_set_schedule(call: ServiceCall) -> dict:
+        return await _async_set_schedule(hass, call)
+
+    hass.services.async_register(
+        DOMAIN,
+        SERVICE_SET_SCHEDULE,
+        handle_set_schedule,
+        schema=SET_SCHEDULE_SCHEMA,
+        supports_response=SupportsResponse.OPTIONAL,
+    )
+
+    async def handle_group_write(call: ServiceCall) -> dict:
+        return await _async_group_write(hass, call)
+
+    hass.services.async_register(
+        DOMAIN,
+        SERVICE_GROUP_WRITE,
+        handle_group_write,
+        schema=GROUP_WRITE_SCHEMA,
+        supports_response=SupportsResponse.OPTIONAL,
+    )
+
+    async def handle_dump_frames(call: ServiceCall) -> dict:
+        return await _async_dump_frames(hass, call)
+
+    hass.services.async_register(
+        DOMAIN,
+        SERVICE_DUMP_FRAMES,
+        handle_dump_frames,
+        schema=DUMP_FRAMES_SCHEMA,
+        supports_response=SupportsResponse.ONLY,
+    )
@@ -3,6 +3,7 @@ import logging
 from homeassistant.components.switch import SwitchEntity
 from homeassistant.helpers.update_coordinator import DataUpdateCoordinator
 
+from .classes.bitfield_writer import compose_to_mask
 from .const import DOMAIN, CONF_ENTITY_PREFIX, DEFAULT_ENTITY_PREFIX
 from .entity import ModbusBridgeEntity
 from .entity_descriptions.switch_types import SWITCH_TYPES
@@ -53,23 +54,22 @@ class ModbusBridgeSwitch(ModbusBridgeEntity, SwitchEntity):
         await self._set_bit_value(0)
 
     async def _set_bit_value(self, value: int) -> None:
-        """Compose the new register value and write it to the inverter."""
+        """Change this switch's bit with a read-modify-write on the inverter.
+
+        The new state is shown right away; the write is confirmed in the
+        background and the coordinator reverts the state if it fails.
+        """
         # Get the shared API client from hass.data
         if not self._api_client:
             _LOGGER.error("API client not found, cannot write to switch '%s'", self.name)
             return
 
-        # Get the current value of the entire register to modify it
-        original_register_value = self.coordinator.data.get(self._register_type, {}).get(self._register, 0)
-
-        # Use the compose function to set the desired bit within the register value
-        new_register_value = self._compose(original_register_value, value)
+        # Only this switch's bit is written; the other bits of the register are
+        # read fresh from the inverter, and concurrent toggles are batched
+        mask, bits = compose_to_mask(self._compose, value)
+        new_register_value = self._api_client.submit_write(self._register, mask, bits)
 
-        # Call the new write method on the API client
-        success = await self._api_client.async_write_register(self._register, new_register_value)
-        
-        if success:
-            # Optimistically update the coordinator's data with the new register value
-            self.coordinator.data[self._register_type][self._register] = new_register_value
-            # Tell HA to update the state of this entity immediately
-            self.async_write_ha_state()
\ No newline at end of file
+        # Update the coordinator's data with the optimistic register value
+        self.coordinator.data[self._register_type][self._register] = new_register_value
+        # Tell HA to update the state of this entity immediately
+        self.async_write_ha_state()
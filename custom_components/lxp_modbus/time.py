@@ -4,6 +4,7 @@ from datetime import time as dt_time
 from homeassistant.components.time import TimeEntity
 from homeassistant.helpers.update_coordinator import DataUpdateCoordinator
 
+from .classes.bitfield_writer import REGISTER_MASK
 from .const import DOMAIN, CONF_ENTITY_PREFIX, DEFAULT_ENTITY_PREFIX
 from .entity import ModbusBridgeEntity
 from .entity_descriptions.time_types import TIME_TYPES
@@ -62,10 +63,9 @@ class ModbusBridgeTime(ModbusBridgeEntity, TimeEntity):
             _LOGGER.error("API client not found, cannot write to time entity '%s'", self.name)
             return
 
-        # Call the write method on the API client
-        success = await self._api_client.async_write_register(self._register, new_register_value)
-        
-        if success:
-            # Optimistically update the coordinator's data and refresh the entity
-            self.coordinator.data[self._register_type][self._register] = new_register_value
-            self.async_write_ha_state()
\ No newline at end of file
+        # Write in the background; the register reverts if the inverter does not confirm it
+        self._api_client.submit_write(self._register, REGISTER_MASK, new_register_value)
+
+        # Optimistically update the coordinator's data and refresh the entity
+        self.coordinator.data[self._register_type][self._register] = new_register_value
+        self.async_write_ha_state()
\ No newline at end of file
@@ -1,3 +1,9 @@
+from .constants.input_registers import (
+    I_PPV1, I_PPV2, I_PPV3, I_PPV4, I_PPV5, I_PPV6, I_VPV3,
+    I_PTOGRID, I_PTOGRID_S, I_PTOGRID_T, I_PTOUSER, I_PTOUSER_S, I_PTOUSER_T,
+    I_VAC_S, I_VAC_T,
+)
+
 def decode_model_from_registers(registers: dict) -> str:
     """
     Decode inverter model from 2 HOLD registers (7 and 8).
@@ -10,6 +16,16 @@ def decode_model_from_registers(registers: dict) -> str:
         chars.append(chr(value & 0xFF))         # Low byte
     return ''.join(chars).strip('\x00').strip()
 
+def contiguous_runs(registers, max_count: int) -> list[tuple[int, int]]:
+    """Group register numbers into (start, count) runs of consecutive registers, each at most max_count long."""
+    runs = []
+    for register in sorted(set(registers)):
+        if runs and runs[-1][0] + runs[-1][1] == register and runs[-1][1] < max_count:
+            runs[-1] = (runs[-1][0], runs[-1][1] + 1)
+        else:
+            runs.append((register, 1))
+    return runs
+
 def get_bits(value: int, start_bit: int, bit_count: int) -> int:
     """Extract bit field from value."""
     mask = (1 << bit_count) - 1
@@ -66,4 +82,33 @@ def get_highest_set_bit(value: int) -> int | None:
     if not isinstance(value, int) or value == 0:
         return None
     # Calculate the position of the most significant bit.
-    return value.bit_length() - 1
\ No newline at end of file
+    return value.bit_length() - 1
+
+def pv_power_total(input_registers: dict) -> int:
+    """Returns the total PV power of one inverter.
+
+    Models without a third PV input report the total PV power in I_PPV3 (and no
+    PV3 voltage); on those it is the total rather than one more string to add.
+    """
+    if input_registers.get(I_VPV3) == 0 and input_registers.get(I_PPV3, 0) > 0:
+        return input_registers[I_PPV3]
+    return sum(input_registers.get(register, 0) for register in (I_PPV1, I_PPV2, I_PPV3, I_PPV4, I_PPV5, I_PPV6))
+
+def grid_power_registers(input_registers: dict) -> tuple[tuple, tuple]:
+    """Returns the (export, import) registers that add up to the grid power of one inverter.
+
+    Three-phase models, recognised by their S/T grid voltages, split the grid power
+    over the R, S and T registers. Single and split-phase models report the total
+    in I_PTOGRID/I_PTOUSER; the L1N/L2N legs of US models are part of it.
+    """
+    if input_registers.get(I_VAC_S) or input_registers.get(I_VAC_T):
+        return (I_PTOGRID, I_PTOGRID_S, I_PTOGRID_T), (I_PTOUSER, I_PTOUSER_S, I_PTOUSER_T)
+    return (I_PTOGRID,), (I_PTOUSER,)
+
+def grid_export_total(input_registers: dict) -> int:
+    """Returns the power exported to the grid by one inverter, over all its phases."""
+    return sum(input_registers.get(register, 0) for register in grid_power_registers(input_registers)[0])
+
+def grid_import_total(input_registers: dict) -> int:
+    """Returns the power imported from the grid by one inverter, over all its phases."""
+    return sum(input_registers.get(register, 0) for register in grid_power_registers(input_registers)[1])
@@ -0,0 +1,96 @@
+"""Tests for the BatterySchedule class."""
+
+import pytest
+from unittest.mock import MagicMock
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.battery_schedule import BatterySchedule
+from custom_components.lxp_modbus.classes.poll_plan import build_battery_pages
+
+
+class TestBatterySchedule:
+    """Test cases for BatterySchedule."""
+
+    @pytest.fixture
+    def clock(self):
+        return MagicMock(return_value=1000.0)
+
+    @pytest.fixture
+    def schedule(self, clock):
+        return BatterySchedule(interval=300, stale_after=900, clock=clock)
+
+    def test_pages_due_once_per_interval(self, schedule, clock):
+        """Test that a read page waits for the interval while the others stay due."""
+        pages = build_battery_pages(40, 2)
+        assert schedule.due_pages(pages) == pages
+
+        schedule.record_page(pages[0], {"BAT0000001": {}})
+        schedule.record_page(pages[1], {})
+        assert schedule.due_pages(pages) == [pages[1]]
+
+        clock.return_value = 1300.0
+        assert schedule.due_pages(pages) == pages
+
+    def test_packs_expire_individually(self, schedule, clock):
+        """Test that each pack goes stale on its own last-seen time."""
+        pages = build_battery_pages(40, 2)
+        schedule.record_page(pages[0], {"BAT0000001": {}})
+        clock.return_value = 1500.0
+        schedule.record_page(pages[1], {"BAT0000002": {}})
+
+        clock.return_value = 1950.0
+        assert schedule.is_fresh("BAT0000001") is False
+        assert schedule.is_fresh("BAT0000002") is True
+        assert schedule.get_stats()["stale"] == ["BAT0000001"]
+
+    def test_restored_packs_expire_like_polled_ones(self, schedule, clock):
+        """Test that packs from a snapshot are available until the staleness window passes."""
+        schedule.restore(["BAT0000001"])
+        assert schedule.is_fresh("BAT0000001") is True
+        assert schedule.is_fresh("BAT0000009") is False
+
+        clock.return_value = 1900.0
+        assert schedule.is_fresh("BAT0000001") is False
+
+    def test_pruned_pages_no_longer_locate_serials(self, schedule):
+        """Test that a page dropped after the pack count shrank no longer holds its serials."""
+        pages = build_battery_pages(40, 2)
+        schedule.record_page(pages[0], {"BAT0000001": {}})
+        assert schedule.covers(pages) is False
+
+        schedule.record_page(pages[1], {"BAT0000002": {}})
+        assert schedule.located == {"BAT0000001", "BAT0000002"}
+
+        schedule.prune(pages[:1])
+        assert schedule.covers(pages[:1]) is True
+        assert schedule.located == {"BAT0000001"}
+
+    def test_page_without_packs_is_taken_as_empty(self, schedule):
+        """Test that a page answering repeatedly without any pack completes the coverage with no serials."""
+        pages = build_battery_pages(40, 1)
+        schedule.record_page(pages[0], {"BAT0000001": {}})
+        schedule.prune([])
+        schedule.record_page(pages[0], {})
+        schedule.record_page(pages[0], {})
+        assert schedule.covers(pages) is False
+        assert schedule.due_pages(pages) == pages
+
+        schedule.record_page(pages[0], {})
+        assert schedule.covers(pages) is True
+        assert schedule.located == set()
+        assert schedule.due_pages(pages) == []
+
+    def test_decoded_pack_resets_empty_reads(self, schedule):
+        """Test that only consecutive reads without packs count towards an empty page."""
+        pages = build_battery_pages(40, 1)
+        schedule.record_page(pages[0], {})
+        schedule.record_page(pages[0], {})
+        schedule.record_page(pages[0], {"BAT0000001": {}})
+        schedule.prune([])
+        schedule.record_page(pages[0], {})
+        assert schedule.covers(pages) is False
+
@@ -0,0 +1,130 @@
+"""Tests for the BitfieldWriteBatcher class."""
+
+import asyncio
+import pytest
+from unittest.mock import AsyncMock
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.bitfield_writer import BitfieldWriteBatcher, compose_to_mask
+from custom_components.lxp_modbus.utils import set_bits
+
+
+class TestComposeToMask:
+    """Test cases for compose_to_mask."""
+
+    def test_single_bit(self):
+        """Test the mask of a one-bit switch."""
+        compose = lambda orig, value: set_bits(orig, 7, 1, value)
+        assert compose_to_mask(compose, 1) == (0x80, 0x80)
+        assert compose_to_mask(compose, 0) == (0x80, 0)
+
+    def test_multi_bit_field(self):
+        """Test the mask of a multi-bit select field."""
+        compose = lambda orig, value: set_bits(orig, 4, 2, value)
+        assert compose_to_mask(compose, 2) == (0x30, 0x20)
+
+    def test_whole_register(self):
+        """Test that a compose ignoring the original value covers the whole register."""
+        assert compose_to_mask(lambda orig, value: value, 3) == (0xFFFF, 3)
+
+
+class TestBitfieldWriteBatcher:
+    """Test cases for BitfieldWriteBatcher."""
+
+    @pytest.mark.asyncio
+    async def test_concurrent_changes_are_merged(self):
+        """Test that changes within the window produce a single write with all masks."""
+        write = AsyncMock(return_value=0x0005)
+        batcher = BitfieldWriteBatcher(write, window=0.01)
+
+        results = await asyncio.gather(
+            batcher.async_write_bits(21, 0x1, 0x1),
+            batcher.async_write_bits(21, 0x4, 0x4),
+            batcher.async_write_bits(21, 0x2, 0x0),
+        )
+
+        write.assert_awaited_once_with(21, 0x7, 0x5)
+        assert results == [0x0005] * 3
+        assert batcher.get_stats() == {"masked_writes": 1, "batched_changes": 2}
+
+    @pytest.mark.asyncio
+    async def test_later_change_of_same_bit_wins(self):
+        """Test that the last request for a bit decides its value."""
+        write = AsyncMock(return_value=0)
+        batcher = BitfieldWriteBatcher(write, window=0.01)
+        await asyncio.gather(batcher.async_write_bits(21, 0x1, 0x1), batcher.async_write_bits(21, 0x1, 0x0))
+        write.assert_awaited_once_with(21, 0x1, 0x0)
+
+    @pytest.mark.asyncio
+    async def test_registers_are_independent(self):
+        """Test that different registers are written separately."""
+        write = AsyncMock(return_value=1)
+        batcher = BitfieldWriteBatcher(write, window=0.01)
+        await asyncio.gather(batcher.async_write_bits(21, 0x1, 0x1), batcher.async_write_bits(110, 0x1, 0x1))
+        assert write.await_count == 2
+
+    @pytest.mark.asyncio
+    async def test_change_during_write_starts_new_batch(self):
+        """Test that a change arriving while the batch is being written is not lost."""
+        release = asyncio.Event()
+
+        async def slow_write(register, mask, bits):
+            await release.wait()
+            return bits
+
+        batcher = BitfieldWriteBatcher(slow_write, window=0)
+        first = asyncio.create_task(batcher.async_write_bits(21, 0x1, 0x1))
+        await asyncio.sleep(0.01)
+        second = asyncio.create_task(batcher.async_write_bits(21, 0x2, 0x2))
+        await asyncio.sleep(0.01)
+        release.set()
+
+        assert await first == 0x1
+        assert await second == 0x2
+
+    @pytest.mark.asyncio
+    async def test_rapid_values_end_in_latest_write(self):
+        """Test that values set while a write is in flight collapse into one write of the latest."""
+        release = asyncio.Event()
+        written = []
+
+        async def slow_write(register, mask, bits):
+            written.append(bits)
+            await release.wait()
+            return bits
+
+        batcher = BitfieldWriteBatcher(slow_write, window=0)
+        first = asyncio.create_task(batcher.async_write_bits(64, 0xFFFF, 10))
+        await asyncio.sleep(0.01)
+        later = [asyncio.create_task(batcher.async_write_bits(64, 0xFFFF, value)) for value in (20, 30, 40)]
+        await asyncio.sleep(0.01)
+        assert batcher.is_busy(64)
+        release.set()
+
+        assert await first == 10
+        assert await asyncio.gather(*later) == [40, 40, 40]
+        assert written == [10, 40]
+        assert not batcher.is_busy(64)
+
+    @pytest.mark.asyncio
+    async def test_window_override(self):
+        """Test that a per-call window replaces the default for the batch it opens."""
+        write = AsyncMock(return_value=5)
+        batcher = BitfieldWriteBatcher(write, window=10)
+        assert await asyncio.wait_for(batcher.async_write_bits(64, 0xFFFF, 5, window=0), 1) == 5
+        write.assert_awaited_once_with(64, 0xFFFF, 5)
+
+    @pytest.mark.asyncio
+    async def test_failure_reaches_every_caller(self):
+        """Test that an exception in the write is raised to all callers of the batch."""
+        batcher = BitfieldWriteBatcher(AsyncMock(side_effect=OSError("boom")), window=0.01)
+        results = await asyncio.gather(
+            batcher.async_write_bits(21, 0x1, 0x1),
+            batcher.async_write_bits(21, 0x2, 0x2),
+            return_exceptions=True,
+        )
+        assert all(isinstance(r, OSError) for r in results)
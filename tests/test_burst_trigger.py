@@ -0,0 +1,87 @@
+"""Tests for the BurstTrigger class and the register poll plan."""
+
+import pytest
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.burst_trigger import BurstTrigger, is_off_grid
+from custom_components.lxp_modbus.classes.poll_plan import build_poll_plan
+from custom_components.lxp_modbus.const import TIER_FAST, TIER_SLOW, TOTAL_REGISTERS
+from custom_components.lxp_modbus.constants.input_registers import (
+    I_STATE, I_INTERNAL_FAULT, I_WARNING_CODE_L, I_PPV1,
+)
+
+
+class TestBurstTrigger:
+    """Test cases for BurstTrigger."""
+
+    @pytest.fixture
+    def trigger(self):
+        """Create a trigger with an on-grid baseline."""
+        trigger = BurstTrigger()
+        assert trigger.detect({I_STATE: 12, I_INTERNAL_FAULT: 0, I_WARNING_CODE_L: 0}) is None
+        return trigger
+
+    def test_is_off_grid(self):
+        """Test off-grid state classification."""
+        for state in (64, 96, 128, 136, 192):
+            assert is_off_grid(state) is True
+        for state in (0, 1, 4, 12, 32, 40):
+            assert is_off_grid(state) is False
+        assert is_off_grid(None) is False
+
+    def test_first_poll_is_baseline_only(self):
+        """Test that the first poll never triggers a burst."""
+        trigger = BurstTrigger()
+        assert trigger.detect({I_STATE: 64, I_INTERNAL_FAULT: 5}) is None
+
+    def test_no_transition(self, trigger):
+        """Test that unrelated register changes do not trigger."""
+        assert trigger.detect({I_STATE: 4, I_INTERNAL_FAULT: 0, I_WARNING_CODE_L: 0, I_PPV1: 1234}) is None
+
+    def test_enter_and_leave_off_grid(self, trigger):
+        """Test that off-grid entry and exit both trigger."""
+        assert trigger.detect({I_STATE: 64, I_INTERNAL_FAULT: 0, I_WARNING_CODE_L: 0}) == "entered off-grid"
+        assert trigger.detect({I_STATE: 192, I_INTERNAL_FAULT: 0, I_WARNING_CODE_L: 0}) is None
+        assert trigger.detect({I_STATE: 12, I_INTERNAL_FAULT: 0, I_WARNING_CODE_L: 0}) == "returned to grid"
+
+    def test_fault_and_warning_changes(self, trigger):
+        """Test that fault and warning register changes trigger."""
+        assert "internal fault" in trigger.detect({I_STATE: 12, I_INTERNAL_FAULT: 3, I_WARNING_CODE_L: 0})
+        assert "warning code" in trigger.detect({I_STATE: 12, I_INTERNAL_FAULT: 3, I_WARNING_CODE_L: 8})
+
+    def test_missing_registers_do_not_trigger(self, trigger):
+        """Test that a partial poll without the watched registers does not trigger."""
+        assert trigger.detect({}) is None
+        assert trigger.detect({I_STATE: 64}) is None
+
+    def test_reset(self, trigger):
+        """Test that reset drops the baseline."""
+        trigger.reset()
+        assert trigger.detect({I_STATE: 64}) is None
+
+
+class TestPollPlan:
+    """Test cases for build_poll_plan."""
+
+    def test_default_block_size(self):
+        """Test the plan for the default block size."""
+        plan = build_poll_plan(125)
+        assert len(plan) == 12
+        assert [b.register_type for b in plan] == ["input"] * 6 + ["hold"] * 6
+        assert [b.tier for b in plan if b.tier == TIER_FAST] == [TIER_FAST]
+        assert plan[0].start == 0 and plan[0].count == 125 and plan[0].function_code == 4
+        assert plan[6].function_code == 3
+
+    def test_legacy_block_size(self):
+        """Test that every register is covered exactly once with small blocks."""
+        plan = build_poll_plan(40)
+        for register_type in ("input", "hold"):
+            covered = [r for b in plan if b.register_type == register_type for r in range(b.start, b.start + b.count)]
+            assert covered == list(range(TOTAL_REGISTERS))
+        fast = [b.start for b in plan if b.tier == TIER_FAST]
+        assert fast == [0, 40, 80, 120]
+        assert all(b.tier == TIER_SLOW for b in plan if b.register_type == "hold")
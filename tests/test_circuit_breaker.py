@@ -0,0 +1,124 @@
+"""Tests for the DongleCircuitBreaker class."""
+
+import pytest
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.circuit_breaker import (
+    DongleCircuitBreaker,
+    STATE_CLOSED,
+    STATE_OPEN,
+    STATE_HALF_OPEN,
+)
+
+
+class FakeClock:
+    """Manually advanced monotonic clock."""
+
+    def __init__(self):
+        self.now = 1000.0
+
+    def __call__(self):
+        return self.now
+
+
+class TestDongleCircuitBreaker:
+    """Test cases for DongleCircuitBreaker."""
+
+    @pytest.fixture
+    def clock(self):
+        return FakeClock()
+
+    @pytest.fixture
+    def breaker(self, clock):
+        """Breaker without jitter so delays are predictable."""
+        return DongleCircuitBreaker(3, base_delay=10, max_delay=60, jitter=0, clock=clock)
+
+    def _trip(self, breaker):
+        for _ in range(breaker.failure_threshold):
+            assert breaker.allow_request() is True
+            breaker.record_failure("refused")
+
+    def test_initially_closed(self, breaker):
+        """Test that a new breaker allows requests."""
+        assert breaker.state == STATE_CLOSED
+        assert breaker.allow_request() is True
+        assert breaker.retry_in == 0
+
+    def test_opens_at_threshold(self, breaker):
+        """Test that the circuit opens after failure_threshold consecutive failures."""
+        breaker.record_failure()
+        breaker.record_failure()
+        assert breaker.state == STATE_CLOSED
+        breaker.record_failure()
+        assert breaker.state == STATE_OPEN
+        assert breaker.allow_request() is False
+        assert breaker.retry_in == 10
+
+    def test_success_resets_failure_count(self, breaker):
+        """Test that a success in between keeps the circuit closed."""
+        breaker.record_failure()
+        breaker.record_failure()
+        breaker.record_success()
+        breaker.record_failure()
+        assert breaker.state == STATE_CLOSED
+
+    def test_half_open_allows_single_probe(self, breaker, clock):
+        """Test that only one probe is let through after the delay."""
+        self._trip(breaker)
+        clock.now += 10
+        assert breaker.state == STATE_HALF_OPEN
+        assert breaker.allow_request() is True
+        assert breaker.allow_request() is False
+
+    def test_released_probe_lets_next_caller_probe(self, breaker, clock):
+        """Test that a probe released without an outcome does not block the circuit."""
+        self._trip(breaker)
+        clock.now += 10
+        assert breaker.allow_request() is True
+        breaker.release_probe()
+        assert breaker.state == STATE_HALF_OPEN
+        assert breaker.allow_request() is True
+
+    def test_probe_success_closes(self, breaker, clock):
+        """Test that a successful probe closes the circuit."""
+        self._trip(breaker)
+        clock.now += 10
+        assert breaker.allow_request() is True
+        breaker.record_success()
+        assert breaker.state == STATE_CLOSED
+        assert breaker.allow_request() is True
+
+    def test_probe_failure_doubles_backoff(self, breaker, clock):
+        """Test exponential backoff up to max_delay on failed probes."""
+        self._trip(breaker)
+        expected = [20, 40, 60, 60]
+        for delay in expected:
+            clock.now += breaker.retry_in
+            assert breaker.allow_request() is True
+            breaker.record_failure()
+            assert breaker.state == STATE_OPEN
+            assert breaker.retry_in == delay
+
+    def test_jitter_bounds(self, clock):
+        """Test that jitter stays within the configured fraction."""
+        low = DongleCircuitBreaker(1, base_delay=10, jitter=0.2, clock=clock, rng=lambda: 0.0)
+        high = DongleCircuitBreaker(1, base_delay=10, jitter=0.2, clock=clock, rng=lambda: 1.0)
+        low.record_failure()
+        high.record_failure()
+        assert low.retry_in == pytest.approx(8)
+        assert high.retry_in == pytest.approx(12)
+
+    def test_as_dict(self, breaker):
+        """Test the diagnostic representation."""
+        self._trip(breaker)
+        breaker.allow_request()
+        info = breaker.as_dict()
+        assert info["state"] == STATE_OPEN
+        assert info["consecutive_failures"] == 3
+        assert info["times_opened"] == 1
+        assert info["rejected_requests"] == 1
+        assert info["last_failure"] == "refused"
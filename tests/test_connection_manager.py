@@ -16,6 +16,7 @@ from custom_components.lxp_modbus.classes.connection_manager import (
     INITIAL_DATA_READ_SIZE,
     INITIAL_DATA_TIMEOUT,
 )
+from custom_components.lxp_modbus.classes.frame_trace import FrameTrace
 
 
 class TestModbusConnectionManager:
@@ -165,7 +166,9 @@ class TestModbusConnectionManager:
 
         with patch(
             'custom_components.lxp_modbus.classes.connection_manager.LxpResponse'
-        ) as mock_response_class:
+        ) as mock_response_class, patch(
+            'custom_components.lxp_modbus.classes.connection_manager._LOGGER.isEnabledFor', return_value=True
+        ):
             mock_response = MagicMock()
             mock_response.info = "test_info"
             mock_response_class.return_value = mock_response
@@ -175,6 +178,23 @@ class TestModbusConnectionManager:
             mock_reader.read.assert_called_once_with(INITIAL_DATA_READ_SIZE)
             mock_response_class.assert_called_once_with(b"some_initial_data")
 
+    @pytest.mark.asyncio
+    async def test_async_discard_initial_data_traced_not_parsed(self, mock_reader):
+        """Test that discarded data goes to the frame trace and is only parsed for debug logging."""
+        trace = FrameTrace()
+        manager = ModbusConnectionManager("192.168.1.100", 8000, 3, True, frame_trace=trace)
+        mock_reader.read.return_value = b"some_initial_data"
+
+        with patch(
+            'custom_components.lxp_modbus.classes.connection_manager.LxpResponse'
+        ) as mock_response_class, patch(
+            'custom_components.lxp_modbus.classes.connection_manager._LOGGER.isEnabledFor', return_value=False
+        ):
+            await manager.async_discard_initial_data(mock_reader)
+
+        mock_response_class.assert_not_called()
+        assert trace.dump()[0]["frame"] == b"some_initial_data".hex()
+
     @pytest.mark.asyncio
     async def test_async_discard_initial_data_skip_disabled(self, manager_no_skip, mock_reader):
         """Test discard initial data when skip is disabled is a no-op."""
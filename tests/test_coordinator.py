@@ -1,5 +1,6 @@
 """Tests for the LxpModbusDataUpdateCoordinator class."""
 
+import asyncio
 import pytest
 from unittest.mock import AsyncMock, MagicMock, patch
 from datetime import timedelta
@@ -11,15 +12,9 @@ import sys
 import os
 sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
 
-from custom_components.lxp_modbus.coordinator import (
-    LxpModbusDataUpdateCoordinator,
-    RECOVERY_MODE_THRESHOLD,
-    RECOVERY_INTERVAL_INITIAL,
-    RECOVERY_INTERVAL_MEDIUM,
-    RECOVERY_INTERVAL_HIGH,
-    RECOVERY_ESCALATION_MEDIUM,
-    RECOVERY_ESCALATION_HIGH,
-)
+from custom_components.lxp_modbus.coordinator import LxpModbusDataUpdateCoordinator
+from custom_components.lxp_modbus.classes.circuit_breaker import DongleCircuitBreaker
+from custom_components.lxp_modbus.const import BURST_POLL_INTERVAL, TIER_FAST, TIER_SLOW
 
 
 class TestLxpModbusDataUpdateCoordinator:
@@ -40,6 +35,9 @@ class TestLxpModbusDataUpdateCoordinator:
         """Create a mock API client with async_get_data."""
         client = AsyncMock()
         client.async_get_data = AsyncMock(return_value={"input": {0: 100}, "hold": {0: 200}})
+        client.circuit_breaker = DongleCircuitBreaker(3, base_delay=15, jitter=0)
+        client.last_poll_live = True
+        client.last_poll_live_tiers = frozenset({TIER_FAST, TIER_SLOW})
         return client
 
     @pytest.fixture
@@ -70,8 +68,6 @@ class TestLxpModbusDataUpdateCoordinator:
         assert coordinator.api_client is mock_api_client
         assert coordinator._failed_updates == 0
         assert coordinator._last_success is None
-        assert coordinator._is_recovering is False
-        assert coordinator._recovery_interval is None
         assert coordinator._original_poll_interval == 30
 
     # ---------------------------------------------------------------
@@ -88,25 +84,7 @@ class TestLxpModbusDataUpdateCoordinator:
         assert data == {"input": {0: 100}, "hold": {0: 200}}
 
     # ---------------------------------------------------------------
-    # 3. _async_update_data - success exits recovery mode
-    # ---------------------------------------------------------------
-    @pytest.mark.asyncio
-    async def test_async_update_data_success_exits_recovery_mode(self, coordinator):
-        """Test that a successful update exits recovery mode and restores normal interval."""
-        cancel_callback = MagicMock()
-        coordinator._is_recovering = True
-        coordinator._recovery_interval = cancel_callback
-
-        data = await coordinator._async_update_data()
-
-        assert coordinator._is_recovering is False
-        assert coordinator._recovery_interval is None
-        cancel_callback.assert_called_once()
-        assert coordinator.update_interval == timedelta(seconds=30)
-        assert data == {"input": {0: 100}, "hold": {0: 200}}
-
-    # ---------------------------------------------------------------
-    # 4. _async_update_data - UpdateFailed increments counter
+    # 3. _async_update_data - UpdateFailed increments counter
     # ---------------------------------------------------------------
     @pytest.mark.asyncio
     async def test_async_update_data_update_failed_increments_counter(self, coordinator):
@@ -120,118 +98,335 @@ class TestLxpModbusDataUpdateCoordinator:
         assert coordinator._failed_updates == 1
 
     # ---------------------------------------------------------------
-    # 5. _start_recovery_mode - sets is_recovering flag
+    # 4. Schedule follows the dongle circuit breaker
     # ---------------------------------------------------------------
-    def test_start_recovery_mode_sets_is_recovering_flag(self, coordinator):
-        """Test that _start_recovery_mode sets the is_recovering flag to True."""
-        coordinator._failed_updates = RECOVERY_MODE_THRESHOLD
+    @pytest.mark.asyncio
+    async def test_open_circuit_schedules_poll_at_probe_time(self, coordinator):
+        """Test that an open circuit moves the next poll to the probe time."""
+        breaker = coordinator.api_client.circuit_breaker
+        for _ in range(3):
+            breaker.record_failure("refused")
 
-        with patch(
-            "custom_components.lxp_modbus.coordinator.async_track_time_interval",
-            return_value=MagicMock(),
-        ):
-            coordinator._start_recovery_mode()
+        await coordinator._async_update_data()
 
-        assert coordinator._is_recovering is True
+        assert coordinator.update_interval == timedelta(seconds=15)
 
-    # ---------------------------------------------------------------
-    # 6. _start_recovery_mode - initial interval is RECOVERY_INTERVAL_INITIAL (15s)
-    # ---------------------------------------------------------------
-    def test_start_recovery_mode_initial_interval(self, coordinator):
-        """Test that _start_recovery_mode uses RECOVERY_INTERVAL_INITIAL when failures are low."""
-        coordinator._failed_updates = RECOVERY_MODE_THRESHOLD  # 3 failures, below escalation thresholds
+    @pytest.mark.asyncio
+    async def test_open_circuit_never_exceeds_poll_interval(self, coordinator):
+        """Test that a long backoff does not delay polls beyond the normal interval."""
+        breaker = DongleCircuitBreaker(1, base_delay=300, jitter=0)
+        coordinator.api_client.circuit_breaker = breaker
+        breaker.record_failure()
 
-        with patch(
-            "custom_components.lxp_modbus.coordinator.async_track_time_interval",
-            return_value=MagicMock(),
-        ) as mock_track:
-            coordinator._start_recovery_mode()
+        await coordinator._async_update_data()
 
-        assert coordinator.update_interval == timedelta(seconds=RECOVERY_INTERVAL_INITIAL)
-        # Verify that async_track_time_interval was called with the initial interval
-        mock_track.assert_called_once()
-        call_args = mock_track.call_args
-        assert call_args[0][2] == timedelta(seconds=RECOVERY_INTERVAL_INITIAL)
+        assert coordinator.update_interval == timedelta(seconds=30)
+
+    @pytest.mark.asyncio
+    async def test_closed_circuit_restores_poll_interval(self, coordinator):
+        """Test that the normal interval is restored once the circuit closes."""
+        coordinator.update_interval = timedelta(seconds=15)
+
+        await coordinator._async_update_data()
+
+        assert coordinator.update_interval == timedelta(seconds=30)
+
+    @pytest.mark.asyncio
+    async def test_failed_update_still_reschedules(self, coordinator):
+        """Test that the schedule is updated even when the update raises."""
+        breaker = coordinator.api_client.circuit_breaker
+        for _ in range(3):
+            breaker.record_failure("refused")
+        coordinator.api_client.async_get_data.side_effect = UpdateFailed("connection lost")
+
+        with pytest.raises(UpdateFailed):
+            await coordinator._async_update_data()
+
+        assert coordinator.update_interval == timedelta(seconds=15)
 
     # ---------------------------------------------------------------
-    # 7. _start_recovery_mode - medium escalation at >10 failures
+    # 5. Burst polling on state transitions
     # ---------------------------------------------------------------
-    def test_start_recovery_mode_medium_escalation(self, coordinator):
-        """Test that recovery interval escalates to RECOVERY_INTERVAL_MEDIUM at >10 failures."""
-        coordinator._failed_updates = RECOVERY_ESCALATION_MEDIUM + 1  # 11 failures
+    @pytest.mark.asyncio
+    async def test_burst_starts_on_off_grid_transition(self, coordinator):
+        """Test that entering off-grid switches to fast-tier burst polling."""
+        coordinator.api_client.async_get_data.return_value = {"input": {0: 12}, "hold": {}}
+        await coordinator._async_update_data()
+        assert coordinator.is_bursting is False
 
-        with patch(
-            "custom_components.lxp_modbus.coordinator.async_track_time_interval",
-            return_value=MagicMock(),
-        ) as mock_track:
-            coordinator._start_recovery_mode()
+        coordinator.api_client.async_get_data.return_value = {"input": {0: 64}, "hold": {}}
+        await coordinator._async_update_data()
+        assert coordinator.is_bursting is True
+        assert coordinator.update_interval == timedelta(seconds=BURST_POLL_INTERVAL)
+
+        await coordinator._async_update_data()
+        assert coordinator.api_client.async_get_data.call_args.kwargs["tiers"] == (TIER_FAST,)
+
+    @pytest.mark.asyncio
+    async def test_no_burst_for_transition_during_outage(self, coordinator):
+        """Test that failed or cached polls drop the baseline, so recovery does not start a burst."""
+        coordinator.api_client.async_get_data.return_value = {"input": {0: 12}, "hold": {}}
+        await coordinator._async_update_data()
 
-        assert coordinator.update_interval == timedelta(seconds=RECOVERY_INTERVAL_MEDIUM)
-        call_args = mock_track.call_args
-        assert call_args[0][2] == timedelta(seconds=RECOVERY_INTERVAL_MEDIUM)
+        coordinator.api_client.async_get_data.side_effect = UpdateFailed("connection lost")
+        with pytest.raises(UpdateFailed):
+            await coordinator._async_update_data()
+        coordinator.api_client.async_get_data.side_effect = None
+        coordinator.api_client.async_get_data.return_value = {"input": {0: 64}, "hold": {}}
+        await coordinator._async_update_data()
+        assert coordinator.is_bursting is False
+
+        # Cached data returned while the dongle is unreachable
+        coordinator.api_client.last_poll_live = False
+        coordinator.api_client.async_get_data.return_value = {"input": {0: 64}, "hold": {}}
+        await coordinator._async_update_data()
+        coordinator.api_client.last_poll_live = True
+        coordinator.api_client.async_get_data.return_value = {"input": {0: 12}, "hold": {}}
+        await coordinator._async_update_data()
+        assert coordinator.is_bursting is False
+
+    def test_reconfigure_resets_burst_baseline(self, coordinator):
+        """Test that a reconfigure drops the baseline of the burst trigger."""
+        coordinator._burst_trigger.detect({0: 12})
+        coordinator.reconfigure(poll_interval=60)
+        assert coordinator._burst_trigger.detect({0: 64}) is None
+
+    @pytest.mark.asyncio
+    async def test_burst_expires_and_restores_full_poll(self, coordinator):
+        """Test that an expired burst restores the normal interval and a full poll."""
+        coordinator._burst_until = 0  # already expired
+        coordinator.update_interval = timedelta(seconds=BURST_POLL_INTERVAL)
+
+        await coordinator._async_update_data()
+
+        assert coordinator.is_bursting is False
+        assert coordinator.update_interval == timedelta(seconds=30)
+        assert coordinator.api_client.async_get_data.call_args.kwargs["tiers"] is None
+
+    @pytest.mark.asyncio
+    async def test_burst_disabled_with_zero_duration(self, coordinator):
+        """Test that a zero burst duration disables burst polling."""
+        coordinator._burst_duration = 0
+        coordinator.api_client.async_get_data.return_value = {"input": {0: 12}, "hold": {}}
+        await coordinator._async_update_data()
+        coordinator.api_client.async_get_data.return_value = {"input": {0: 64}, "hold": {}}
+        await coordinator._async_update_data()
+
+        assert coordinator.is_bursting is False
+        assert coordinator.update_interval == timedelta(seconds=30)
 
     # ---------------------------------------------------------------
-    # 8. _start_recovery_mode - high escalation at >20 failures
+    # 6. Single-flight refresh coalescing
     # ---------------------------------------------------------------
-    def test_start_recovery_mode_high_escalation(self, coordinator):
-        """Test that recovery interval escalates to RECOVERY_INTERVAL_HIGH at >20 failures."""
-        coordinator._failed_updates = RECOVERY_ESCALATION_HIGH + 1  # 21 failures
+    @pytest.mark.asyncio
+    async def test_concurrent_refreshes_join_in_flight_poll(self, coordinator):
+        """Test that refreshes arriving during a poll share its result."""
+        release = asyncio.Event()
 
-        with patch(
-            "custom_components.lxp_modbus.coordinator.async_track_time_interval",
-            return_value=MagicMock(),
-        ) as mock_track:
-            coordinator._start_recovery_mode()
+        async def slow_poll(tiers=None, on_block=None):
+            await release.wait()
+            return {"input": {0: 1}, "hold": {}}
+
+        coordinator.api_client.async_get_data.side_effect = slow_poll
+
+        first = asyncio.create_task(coordinator._async_update_data())
+        await asyncio.sleep(0)
+        joiners = [asyncio.create_task(coordinator._async_update_data()) for _ in range(3)]
+        await asyncio.sleep(0)
+        release.set()
+        results = await asyncio.gather(first, *joiners)
+
+        assert coordinator.api_client.async_get_data.call_count == 1
+        assert all(result == {"input": {0: 1}, "hold": {}} for result in results)
+        assert coordinator.joined_polls == 3
+
+    @pytest.mark.asyncio
+    async def test_joined_refresh_fails_when_poll_is_cancelled(self, coordinator):
+        """Test that cancelling the in-flight poll cancels only its caller; joined callers get UpdateFailed."""
+        async def hanging_poll(tiers=None, on_block=None):
+            await asyncio.Event().wait()
+
+        coordinator.api_client.async_get_data.side_effect = hanging_poll
+
+        first = asyncio.create_task(coordinator._async_update_data())
+        await asyncio.sleep(0)
+        joiner = asyncio.create_task(coordinator._async_update_data())
+        await asyncio.sleep(0)
+        first.cancel()
+
+        with pytest.raises(asyncio.CancelledError):
+            await first
+        with pytest.raises(UpdateFailed):
+            await joiner
+        assert not joiner.cancelled()
+
+        # The next refresh starts its own poll
+        coordinator.api_client.async_get_data.side_effect = None
+        assert await coordinator._async_update_data() == {"input": {0: 100}, "hold": {0: 200}}
+
+    @pytest.mark.asyncio
+    async def test_joined_refresh_receives_poll_failure(self, coordinator):
+        """Test that a failing poll propagates its error to joined callers."""
+        release = asyncio.Event()
+
+        async def failing_poll(tiers=None, on_block=None):
+            await release.wait()
+            raise UpdateFailed("connection lost")
+
+        coordinator.api_client.async_get_data.side_effect = failing_poll
+
+        first = asyncio.create_task(coordinator._async_update_data())
+        await asyncio.sleep(0)
+        joiner = asyncio.create_task(coordinator._async_update_data())
+        await asyncio.sleep(0)
+        release.set()
+
+        with pytest.raises(UpdateFailed):
+            await first
+        with pytest.raises(UpdateFailed):
+            await joiner
+        assert coordinator._failed_updates == 1
+
+    @pytest.mark.asyncio
+    async def test_requests_during_poll_queue_single_follow_up(self, coordinator):
+        """Test that several refresh requests during a poll queue exactly one follow-up."""
+        release = asyncio.Event()
+
+        async def slow_poll(tiers=None, on_block=None):
+            await release.wait()
+            return {"input": {}, "hold": {}}
+
+        coordinator.api_client.async_get_data.side_effect = slow_poll
 
-        assert coordinator.update_interval == timedelta(seconds=RECOVERY_INTERVAL_HIGH)
-        call_args = mock_track.call_args
-        assert call_args[0][2] == timedelta(seconds=RECOVERY_INTERVAL_HIGH)
+        poll = asyncio.create_task(coordinator._async_update_data())
+        await asyncio.sleep(0)
+        for _ in range(5):
+            await coordinator.async_request_refresh()
+        release.set()
+        await poll
+
+        assert coordinator.hass.async_create_task.call_count == 1
+        assert coordinator._refresh_queued is False
 
     # ---------------------------------------------------------------
-    # 9. _start_recovery_mode - doesn't restart if already recovering
+    # 7. Progressive first poll
     # ---------------------------------------------------------------
-    def test_start_recovery_mode_no_restart_if_already_recovering(self, coordinator):
-        """Test that _start_recovery_mode is a no-op when already in recovery mode."""
-        coordinator._is_recovering = True
-        original_interval = coordinator.update_interval
+    @pytest.mark.asyncio
+    async def test_first_poll_publishes_partial_data(self, coordinator):
+        """Test that only the first poll pushes block-by-block updates to entities."""
+        coordinator.async_update_listeners = MagicMock()
+
+        async def progressive_poll(tiers=None, on_block=None):
+            data = {"input": {}, "hold": {}, "battery": {}}
+            if on_block:
+                data["input"][0] = 12
+                on_block(data)
+            return data
+
+        coordinator.api_client.async_get_data.side_effect = progressive_poll
+        await coordinator._async_update_data()
+        coordinator.async_update_listeners.assert_called_once()
+        assert coordinator.data["input"] == {0: 12}
+
+        await coordinator._async_update_data()
+        assert coordinator.api_client.async_get_data.call_args.kwargs["on_block"] is None
+        coordinator.async_update_listeners.assert_called_once()
 
-        with patch(
-            "custom_components.lxp_modbus.coordinator.async_track_time_interval",
-            return_value=MagicMock(),
-        ) as mock_track:
-            coordinator._start_recovery_mode()
+    @pytest.mark.asyncio
+    async def test_first_poll_without_live_data_stays_progressive(self, coordinator):
+        """Test that a failed first poll does not end block-by-block publishing."""
+        coordinator.api_client.last_poll_live = False
+        await coordinator._async_update_data()
+
+        coordinator.api_client.last_poll_live = True
+        await coordinator._async_update_data()
+        assert coordinator.api_client.async_get_data.call_args.kwargs["on_block"] is not None
+
+        await coordinator._async_update_data()
+        assert coordinator.api_client.async_get_data.call_args.kwargs["on_block"] is None
 
-        # async_track_time_interval should not have been called
-        mock_track.assert_not_called()
-        # The update interval should remain unchanged
-        assert coordinator.update_interval == original_interval
+    # ---------------------------------------------------------------
+    # 8. Live reconfiguration
+    # ---------------------------------------------------------------
+    def test_reconfigure_poll_interval(self, coordinator):
+        """Test that a new poll interval is applied without recreating the coordinator."""
+        coordinator.reconfigure(poll_interval=10)
+        assert coordinator.update_interval == timedelta(seconds=10)
+
+    def test_reconfigure_disabling_burst_ends_it(self, coordinator):
+        """Test that setting the burst duration to 0 ends an active burst."""
+        coordinator._burst_until = float("inf")
+        coordinator.reconfigure(burst_duration=0)
+        assert coordinator.is_bursting is False
+        assert coordinator.update_interval == timedelta(seconds=30)
 
     # ---------------------------------------------------------------
-    # 10. Recovery mode threshold triggers at RECOVERY_MODE_THRESHOLD (3) failures
+    # 9. Fast polling for control loops
     # ---------------------------------------------------------------
     @pytest.mark.asyncio
-    async def test_recovery_mode_triggers_at_threshold(self, coordinator):
-        """Test that recovery mode is triggered exactly at RECOVERY_MODE_THRESHOLD consecutive failures."""
-        coordinator.api_client.async_get_data.side_effect = UpdateFailed("connection lost")
+    async def test_fast_poll_interleaves_full_polls(self, coordinator):
+        """Test that a fast loop polls the fast tier between full polls at the poll interval."""
+        coordinator.set_fast_poll_interval(3)
+        assert coordinator.update_interval == timedelta(seconds=3)
 
-        with patch(
-            "custom_components.lxp_modbus.coordinator.async_track_time_interval",
-            return_value=MagicMock(),
-        ):
-            # Fail (RECOVERY_MODE_THRESHOLD - 1) times -- recovery should NOT trigger yet
-            for i in range(RECOVERY_MODE_THRESHOLD - 1):
-                with pytest.raises(UpdateFailed):
-                    await coordinator._async_update_data()
+        with patch("custom_components.lxp_modbus.coordinator.time_lib.monotonic", return_value=1000):
+            await coordinator._async_update_data()
+            await coordinator._async_update_data()
+        with patch("custom_components.lxp_modbus.coordinator.time_lib.monotonic", return_value=1031):
+            await coordinator._async_update_data()
 
-            assert coordinator._failed_updates == RECOVERY_MODE_THRESHOLD - 1
-            assert coordinator._is_recovering is False
+        tiers = [c.kwargs["tiers"] for c in coordinator.api_client.async_get_data.call_args_list]
+        assert tiers == [None, (TIER_FAST,), None]
 
-            # One more failure should cross the threshold and trigger recovery
-            with pytest.raises(UpdateFailed):
-                await coordinator._async_update_data()
+        coordinator.set_fast_poll_interval(None)
+        assert coordinator.update_interval == timedelta(seconds=30)
 
-            assert coordinator._failed_updates == RECOVERY_MODE_THRESHOLD
-            assert coordinator._is_recovering is True
+    @pytest.mark.asyncio
+    async def test_group_member_polls_on_cycle_boundaries(self, coordinator):
+        """Test that a group member schedules polls on the group's boundaries and tags them by fast-tier read time."""
+        group = MagicMock(period=30)
+        group.seconds_to_next_cycle.return_value = 12.5
+        group.cycle_of_read.return_value = 57
+        coordinator.api_client.last_fast_tier_read = 1712.5
+        coordinator.api_client.last_fast_tier_inputs = {0: 100}
+        coordinator.join_group(group, "entry1")
+        assert coordinator.update_interval == timedelta(seconds=12.5)
+
+        await coordinator._async_update_data()
+        group.cycle_of_read.assert_called_once_with(1712.5)
+        group.record.assert_called_once_with("entry1", 57, {0: 100})
+        assert coordinator.cycle_id == 57
+
+        # A read delayed past the cycle's window is dropped
+        group.cycle_of_read.return_value = None
+        await coordinator._async_update_data()
+        group.record.assert_called_once()
+
+        # Burst polls are off-cycle
+        coordinator._burst_until = float("inf")
+        await coordinator._async_update_data()
+        group.record.assert_called_once()
+
+    @pytest.mark.asyncio
+    async def test_group_member_skips_cached_polls(self, coordinator):
+        """Test that a poll that fell back to cached data does not count towards the group cycle."""
+        group = MagicMock(period=30)
+        group.seconds_to_next_cycle.return_value = 12.5
+        group.cycle_of_read.return_value = 57
+        coordinator.api_client.last_fast_tier_read = 1712.5
+        coordinator.join_group(group, "entry1")
+
+        coordinator.api_client.last_poll_live = False
+        coordinator.api_client.last_poll_live_tiers = frozenset()
+        await coordinator._async_update_data()
+        group.record.assert_not_called()
+        assert coordinator.cycle_id is None
+
+        # Slow blocks alone do not make the fast-tier snapshot live either
+        coordinator.api_client.last_poll_live = True
+        coordinator.api_client.last_poll_live_tiers = frozenset({TIER_SLOW})
+        await coordinator._async_update_data()
+        group.record.assert_not_called()
 
 
 if __name__ == "__main__":
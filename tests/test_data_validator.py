@@ -8,6 +8,7 @@ sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
 
 from custom_components.lxp_modbus.classes.data_validator import (
     is_data_sane,
+    is_time_value_sane,
     HOLD_TIME_REGISTERS,
     INPUT_TIME_REGISTERS,
 )
@@ -277,5 +278,15 @@ class TestIsDataSane:
         assert is_data_sane(registers, "hold") is False
 
 
+
+class TestIsTimeValueSane:
+    """Tests for the packed time value check shared with the schedule service."""
+
+    @pytest.mark.parametrize("hour,minute,expected", [
+        (0, 0, True), (23, 59, True), (24, 0, False), (12, 60, False),
+    ])
+    def test_time_values(self, hour, minute, expected):
+        assert is_time_value_sane(_encode_time(hour, minute)) is expected
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v"])
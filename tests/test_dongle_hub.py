@@ -0,0 +1,90 @@
+"""Tests for the DongleHub class."""
+
+from unittest.mock import MagicMock
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.dongle_hub import DongleHub
+
+
+class TestDongleHub:
+    """Test cases for DongleHub."""
+
+    def test_entries_on_one_dongle_share_a_session(self):
+        """Test that the lock and circuit breaker are shared per host and port only."""
+        hub = DongleHub()
+        first = hub.acquire("10.0.0.5", 8000)
+        second = hub.acquire("10.0.0.5", 8000)
+        other = hub.acquire("10.0.0.6", 8000)
+
+        assert first is second
+        assert first.lock is second.lock
+        assert first.circuit_breaker is second.circuit_breaker
+        assert other is not first
+
+    def test_routes_frames_by_inverter_serial(self):
+        """Test that a frame reaches the handler of the inverter it belongs to."""
+        hub = DongleHub()
+        session = hub.acquire("10.0.0.5", 8000)
+        handler_a, handler_b = MagicMock(), MagicMock()
+        session.register("a", "AAAAAAAAAA", handler_a, 3)
+        session.register("b", "BBBBBBBBBB", handler_b, 3)
+
+        response = MagicMock(serial_number=b"BBBBBBBBBB")
+        assert session.route(response) is True
+        handler_b.assert_called_once_with(response)
+        handler_a.assert_not_called()
+        assert session.route(MagicMock(serial_number=b"CCCCCCCCCC")) is False
+        assert hub.get_stats()[0]["routed_frames"] == 1
+
+    def test_session_dropped_with_last_inverter(self):
+        """Test that a dongle's session lives as long as one of its inverters is loaded."""
+        hub = DongleHub()
+        session = hub.acquire("10.0.0.5", 8000)
+        session.register("a", "AAAAAAAAAA", MagicMock(), 3)
+        session.register("b", "BBBBBBBBBB", MagicMock(), 3)
+
+        hub.release(session, "a")
+        assert hub.acquire("10.0.0.5", 8000) is session
+        hub.release(session, "b")
+        assert hub.get_stats() == []
+        assert hub.acquire("10.0.0.5", 8000) is not session
+
+    def test_breaker_threshold_follows_largest_setting(self):
+        """Test that the shared breaker uses the largest retries setting of the registered inverters."""
+        hub = DongleHub()
+        session = hub.acquire("10.0.0.5", 8000)
+        session.register("a", "AAAAAAAAAA", MagicMock(), 3)
+        session.register("b", "BBBBBBBBBB", MagicMock(), 5)
+        assert session.circuit_breaker.failure_threshold == 5
+
+        session.set_connection_retries("a", 8)
+        assert session.circuit_breaker.failure_threshold == 8
+
+        hub.release(session, "a")
+        assert session.circuit_breaker.failure_threshold == 5
+        assert session.inverters == ["BBBBBBBBBB"]
+
+    def test_duplicate_entries_of_one_inverter_keep_routing(self):
+        """Test that two entries of the same inverter both get its frames and unloading one spares the other."""
+        hub = DongleHub()
+        session = hub.acquire("10.0.0.5", 8000)
+        handler_1, handler_2 = MagicMock(), MagicMock()
+        session.register("entry_1", "AAAAAAAAAA", handler_1, 3)
+        session.register("entry_2", "AAAAAAAAAA", handler_2, 3)
+        assert session.inverters == ["AAAAAAAAAA"]
+
+        response = MagicMock(serial_number=b"AAAAAAAAAA")
+        assert session.route(response) is True
+        handler_1.assert_called_once_with(response)
+        handler_2.assert_called_once_with(response)
+
+        hub.release(session, "entry_1")
+        assert session.route(response) is True
+        assert handler_2.call_count == 2
+        assert handler_1.call_count == 1
+        assert hub.acquire("10.0.0.5", 8000) is session
+
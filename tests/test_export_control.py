@@ -0,0 +1,135 @@
+"""Tests for the ExportLimitController class."""
+
+import pytest
+from unittest.mock import MagicMock, patch
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.export_control import ExportLimitController, next_feed_in_percent
+from custom_components.lxp_modbus.const import (
+    EXPORT_CONTROL_BUDGET_WINDOW,
+    EXPORT_CONTROL_MAX_STEP,
+    EXPORT_CONTROL_PERIOD,
+    EXPORT_CONTROL_WRITE_BUDGET,
+    TIER_FAST,
+)
+from custom_components.lxp_modbus.constants.hold_registers import H_MAX_BACKFLOW_POWER
+from custom_components.lxp_modbus.constants.input_registers import (
+    I_PTOGRID, I_PTOGRID_S, I_PTOGRID_T, I_PTOUSER, I_PTOUSER_S, I_PTOUSER_T, I_VAC_S, I_VAC_T,
+)
+
+
+class TestNextFeedInPercent:
+    """Test cases for next_feed_in_percent."""
+
+    def test_holds_within_hysteresis(self):
+        """Test that export close to the limit leaves the setting alone."""
+        assert next_feed_in_percent(40, 30, 0, 5000) is None
+        assert next_feed_in_percent(40, 1040, 1000, 5000) is None
+
+    def test_lowers_on_excess_export(self):
+        """Test that the step follows the error in percent of rated power."""
+        assert next_feed_in_percent(40, 260, 0, 5000) == 34
+        assert next_feed_in_percent(40, 4000, 0, 5000) == 40 - EXPORT_CONTROL_MAX_STEP
+        assert next_feed_in_percent(3, 4000, 0, 5000) == 0
+
+    def test_raises_while_importing(self):
+        """Test that the limit opens up again when the grid supplies the house."""
+        assert next_feed_in_percent(0, -120, 0, 5000) == 3
+        assert next_feed_in_percent(100, -500, 0, 5000) is None
+
+
+class TestExportLimitController:
+    """Test cases for ExportLimitController."""
+
+    @pytest.fixture
+    def coordinator(self):
+        coordinator = MagicMock()
+        coordinator.data = {"input": {I_PTOGRID: 600, I_PTOUSER: 0}, "hold": {H_MAX_BACKFLOW_POWER: 50}}
+        coordinator.listeners = []
+        coordinator.async_add_listener = lambda cb: coordinator.listeners.append(cb) or (lambda: coordinator.listeners.remove(cb))
+        return coordinator
+
+    @pytest.fixture
+    def api_client(self, coordinator):
+        client = MagicMock()
+        client.data_is_stale = False
+        client.last_poll_live_tiers = frozenset({TIER_FAST})
+        client.last_fast_tier_inputs = coordinator.data["input"]
+        return client
+
+    def test_adjusts_and_rate_limits(self, coordinator, api_client):
+        """Test that updates adjust the feed-in limit at most once per write interval."""
+        controller = ExportLimitController(coordinator, api_client, limit=0, rated_power=5000)
+        controller.start()
+        coordinator.set_fast_poll_interval.assert_called_once_with(EXPORT_CONTROL_PERIOD)
+
+        with patch("custom_components.lxp_modbus.export_control.time_lib.monotonic", side_effect=[100, 102, 107]):
+            for _ in range(3):
+                coordinator.listeners[0]()
+
+        assert api_client.submit_write.call_count == 2
+        assert api_client.submit_write.call_args[0] == (H_MAX_BACKFLOW_POWER, 0xFFFF, 40)
+        assert controller.adjustments == 2
+
+        controller.stop()
+        assert coordinator.listeners == []
+        coordinator.set_fast_poll_interval.assert_called_with(None)
+
+    def test_ignores_stale_data(self, coordinator, api_client):
+        """Test that a restored snapshot does not drive the loop."""
+        api_client.data_is_stale = True
+        controller = ExportLimitController(coordinator, api_client, limit=0, rated_power=5000)
+        controller.start()
+        coordinator.listeners[0]()
+        api_client.submit_write.assert_not_called()
+
+    def test_ignores_failed_fast_read(self, coordinator, api_client):
+        """Test that cached grid power after a failed fast-tier read does not drive the loop."""
+        api_client.last_poll_live_tiers = frozenset()
+        controller = ExportLimitController(coordinator, api_client, limit=0, rated_power=5000)
+        controller.start()
+        coordinator.listeners[0]()
+        api_client.submit_write.assert_not_called()
+
+    def test_sums_three_phases(self, coordinator, api_client):
+        """Test that the export of a three-phase model covers all phases, read live on the fast tier."""
+        # R exports 100 W, but S and T together bring the total to 600 W
+        api_client.last_fast_tier_inputs = {I_PTOGRID: 100, I_PTOUSER: 0, I_VAC_S: 2300, I_VAC_T: 2300}
+        controller = ExportLimitController(coordinator, api_client, limit=0, rated_power=5000)
+        controller.start()
+
+        # The S/T registers were not part of the fast read yet: pin them and wait
+        coordinator.listeners[0]()
+        api_client.submit_write.assert_not_called()
+        key, registers = api_client.pin_fast_registers.call_args[0]
+        assert {I_PTOGRID_S, I_PTOGRID_T} <= set(registers)
+
+        api_client.last_fast_tier_inputs = {I_PTOGRID: 100, I_PTOUSER: 0, I_PTOGRID_S: 250, I_PTOGRID_T: 250,
+                                            I_PTOUSER_S: 0, I_PTOUSER_T: 0, I_VAC_S: 2300, I_VAC_T: 2300}
+        coordinator.listeners[0]()
+        assert api_client.submit_write.call_args[0] == (H_MAX_BACKFLOW_POWER, 0xFFFF, 40)
+
+        controller.stop()
+        api_client.unpin_fast_registers.assert_called_once_with(key)
+
+    def test_write_budget(self, coordinator, api_client):
+        """Test that the EEPROM-backed register is written at most the budget per window."""
+        controller = ExportLimitController(coordinator, api_client, limit=0, rated_power=5000)
+        controller.start()
+
+        times = [i * 10 for i in range(EXPORT_CONTROL_WRITE_BUDGET + 1)]
+        with patch("custom_components.lxp_modbus.export_control.time_lib.monotonic", side_effect=times):
+            for _ in times:
+                coordinator.listeners[0]()
+        assert api_client.submit_write.call_count == EXPORT_CONTROL_WRITE_BUDGET
+        assert controller.budget_holds == 1
+
+        # Once the first write leaves the window the controller adjusts again
+        with patch("custom_components.lxp_modbus.export_control.time_lib.monotonic",
+                   return_value=EXPORT_CONTROL_BUDGET_WINDOW):
+            coordinator.listeners[0]()
+        assert api_client.submit_write.call_count == EXPORT_CONTROL_WRITE_BUDGET + 1
@@ -0,0 +1,280 @@
+"""Tests for the ForceChargeSession class."""
+
+import asyncio
+import pytest
+from unittest.mock import AsyncMock, MagicMock, patch
+from datetime import datetime, timedelta
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from homeassistant.exceptions import HomeAssistantError
+
+from custom_components.lxp_modbus.force_charge import (
+    ForceChargeSession,
+    build_charge_settings,
+    REASON_DEADLINE,
+    REASON_TARGET_REACHED,
+)
+from custom_components.lxp_modbus.const import EVENT_FORCE_CHARGE_FINISHED, TIER_FAST, TIER_SLOW
+from custom_components.lxp_modbus.constants.hold_registers import (
+    H_AC_CHARGE_BAT_CURRENT,
+    H_AC_CHARGE_END_TIME_2,
+    H_AC_CHARGE_SOC_LIMIT,
+    H_AC_CHARGE_START_TIME_2,
+    H_FUNCTION_ENABLE_1,
+    H_SYSTEM_ENABLE_2,
+)
+from custom_components.lxp_modbus.constants.input_registers import I_SOC_SOH
+
+
+class TestBuildChargeSettings:
+    """Test cases for build_charge_settings."""
+
+    def test_settings(self):
+        """Test the registers and masks of a forced charge crossing midnight."""
+        values, masks = build_charge_settings(datetime(2024, 1, 1, 23, 30), 90, 95, charge_current=50)
+
+        assert values[H_FUNCTION_ENABLE_1] == 0x80
+        assert masks[H_FUNCTION_ENABLE_1] == 0x80
+        assert values[H_SYSTEM_ENABLE_2] == 0b0010
+        assert masks[H_SYSTEM_ENABLE_2] == 0b1110
+        assert values[H_AC_CHARGE_SOC_LIMIT] == 95
+        assert values[H_AC_CHARGE_START_TIME_2] == 23 | (30 << 8)
+        assert values[H_AC_CHARGE_END_TIME_2] == 1 | (0 << 8)
+        assert values[H_AC_CHARGE_BAT_CURRENT] == 50
+
+    def test_current_is_optional(self):
+        """Test that the charge current is left alone when not given."""
+        values, _ = build_charge_settings(datetime(2024, 1, 1, 12, 0), 60, 80)
+        assert H_AC_CHARGE_BAT_CURRENT not in values
+
+
+class TestForceChargeSession:
+    """Test cases for ForceChargeSession."""
+
+    @pytest.fixture
+    def mock_hass(self):
+        hass = MagicMock()
+        hass.async_create_task = lambda coro: asyncio.ensure_future(coro)
+        return hass
+
+    @pytest.fixture
+    def coordinator(self):
+        coordinator = MagicMock()
+        coordinator.data = {"input": {I_SOC_SOH: (100 << 8) | 40}, "hold": {}}
+        coordinator.listeners = []
+        coordinator.async_add_listener = lambda cb: coordinator.listeners.append(cb) or (lambda: coordinator.listeners.remove(cb))
+        return coordinator
+
+    @pytest.fixture
+    def api_client(self):
+        client = MagicMock()
+        client.cached_data = {"hold": {}}
+        client.data_is_stale = False
+        client.last_poll_live_tiers = frozenset({TIER_FAST, TIER_SLOW})
+        client.async_write_registers = AsyncMock(side_effect=[
+            {"success": True, "changed": [21, 67], "failed": [], "rolled_back": False,
+             "previous": {21: 0x0001, 67: 100}},
+            {"success": True, "changed": [21, 67], "failed": [], "rolled_back": False,
+             "previous": {21: 0x0081, 67: 95}},
+        ])
+        return client
+
+    @pytest.fixture
+    def store(self):
+        """Patch the Home Assistant Store used for the persisted session."""
+        with patch("custom_components.lxp_modbus.force_charge.Store") as mock_store_cls:
+            store = MagicMock()
+            store.async_load = AsyncMock(return_value=None)
+            store.async_save = AsyncMock()
+            store.async_remove = AsyncMock()
+            mock_store_cls.return_value = store
+            yield store
+
+    @pytest.fixture
+    def session(self, mock_hass, coordinator, api_client, store):
+        return ForceChargeSession(mock_hass, "entry1", coordinator, api_client, target_soc=95, duration=60)
+
+    @pytest.mark.asyncio
+    async def test_restores_when_target_reached(self, session, mock_hass, coordinator, api_client):
+        """Test that reaching the target SOC restores the previous values with the same masks."""
+        with patch("custom_components.lxp_modbus.force_charge.async_call_later", return_value=MagicMock()) as call_later:
+            await session.async_start(datetime(2024, 1, 1, 12, 0))
+        call_later.assert_called_once()
+        assert call_later.call_args[0][1] == 3600
+
+        # Below the target nothing happens
+        for listener in list(coordinator.listeners):
+            listener()
+        await asyncio.sleep(0)
+        assert api_client.async_write_registers.await_count == 1
+
+        coordinator.data["input"][I_SOC_SOH] = (100 << 8) | 95
+        for listener in list(coordinator.listeners):
+            listener()
+        await asyncio.sleep(0.01)
+
+        restore_values, restore_masks = api_client.async_write_registers.await_args[0]
+        assert restore_values == {21: 0x0001, 67: 100}
+        assert restore_masks == {21: 0x80}
+        assert not session.active
+        assert coordinator.listeners == []
+        call_later.return_value.assert_called_once()
+        mock_hass.bus.async_fire.assert_called_once_with(EVENT_FORCE_CHARGE_FINISHED, {
+            "entry_id": "entry1", "reason": REASON_TARGET_REACHED, "soc": 95, "restored": True})
+
+    @pytest.mark.asyncio
+    async def test_restores_at_deadline(self, session, mock_hass, coordinator, api_client):
+        """Test that the deadline ends the charge once."""
+        with patch("custom_components.lxp_modbus.force_charge.async_call_later", return_value=MagicMock()) as call_later:
+            await session.async_start(datetime(2024, 1, 1, 12, 0))
+        deadline = call_later.call_args[0][2]
+
+        deadline(None)
+        await asyncio.sleep(0.01)
+        assert await session.async_stop(REASON_DEADLINE) is False
+
+        assert api_client.async_write_registers.await_count == 2
+        assert mock_hass.bus.async_fire.call_args[0][1]["reason"] == REASON_DEADLINE
+
+    @pytest.mark.asyncio
+    async def test_failed_start_raises(self, session, api_client):
+        """Test that nothing is monitored when the settings could not be applied."""
+        api_client.async_write_registers = AsyncMock(return_value={
+            "success": False, "changed": [], "failed": [21], "rolled_back": True, "previous": {}})
+
+        with patch("custom_components.lxp_modbus.force_charge.async_call_later") as call_later:
+            with pytest.raises(HomeAssistantError):
+                await session.async_start(datetime(2024, 1, 1, 12, 0))
+        call_later.assert_not_called()
+        assert not session.active
+
+    @pytest.mark.asyncio
+    async def test_failed_start_without_rollback_restores(self, session, api_client, store):
+        """Test that settings left behind by a failed start are restored bitwise right away."""
+        api_client.async_write_registers = AsyncMock(side_effect=[
+            {"success": False, "changed": [], "failed": [21, 67], "rolled_back": False,
+             "previous": {21: 0x0001, 67: 100}},
+            {"success": True, "changed": [21, 67], "failed": [], "rolled_back": False,
+             "previous": {21: 0x0081, 67: 95}},
+        ])
+
+        with pytest.raises(HomeAssistantError, match="previous values restored"):
+            await session.async_start(datetime(2024, 1, 1, 12, 0))
+
+        restore_values, restore_masks = api_client.async_write_registers.await_args[0]
+        assert restore_values == {21: 0x0001, 67: 100}
+        assert restore_masks == {21: 0x80}
+        store.async_remove.assert_awaited_once()
+        assert not session.active
+
+    @pytest.mark.asyncio
+    async def test_failed_start_restore_left_to_next_setup(self, session, api_client, store):
+        """Test that a failed start whose restore also fails stays persisted past its deadline."""
+        api_client.async_write_registers = AsyncMock(return_value={
+            "success": False, "changed": [], "failed": [21], "rolled_back": False, "previous": {21: 0x0001}})
+
+        with pytest.raises(HomeAssistantError):
+            await session.async_start(datetime(2024, 1, 1, 12, 0))
+
+        saved = store.async_save.await_args[0][0]
+        assert saved["deadline"] == "2024-01-01T12:00:00"
+        assert saved["previous"] == {"21": 0x0001}
+        store.async_remove.assert_not_awaited()
+
+    @pytest.mark.asyncio
+    async def test_state_persisted_until_restored(self, session, api_client, store):
+        """Test that the previous values and the deadline are stored until the restore succeeds."""
+        with patch("custom_components.lxp_modbus.force_charge.async_call_later", return_value=MagicMock()):
+            await session.async_start(datetime(2024, 1, 1, 12, 0))
+
+        saved = store.async_save.await_args[0][0]
+        assert saved["deadline"] == "2024-01-01T13:00:00"
+        assert saved["previous"] == {"21": 0x0001, "67": 100}
+        assert saved["masks"] == {"21": 0x80, "120": 0b1110}
+        store.async_remove.assert_not_awaited()
+
+        await session.async_stop(REASON_DEADLINE)
+        store.async_remove.assert_awaited_once()
+
+    @pytest.mark.asyncio
+    async def test_failed_restore_stays_persisted(self, session, api_client, store):
+        """Test that a failed restore keeps the state for the next setup to retry."""
+        with patch("custom_components.lxp_modbus.force_charge.async_call_later", return_value=MagicMock()):
+            await session.async_start(datetime(2024, 1, 1, 12, 0))
+        api_client.async_write_registers = AsyncMock(return_value={
+            "success": False, "changed": [], "failed": [21], "rolled_back": False, "previous": {}})
+
+        assert await session.async_stop(REASON_DEADLINE) is False
+        store.async_remove.assert_not_awaited()
+
+    @pytest.mark.asyncio
+    async def test_resume_after_restart(self, mock_hass, coordinator, api_client, store):
+        """Test that a loaded session watches the SOC again for the time that is left."""
+        store.async_load.return_value = {
+            "target_soc": 95, "duration": 60, "charge_current": None, "deadline": "2024-01-01T13:00:00",
+            "previous": {"21": 0x0001, "67": 100}, "masks": {"21": 0x80, "120": 0b1110}}
+
+        session = await ForceChargeSession.async_load(mock_hass, "entry1", coordinator, api_client)
+        with patch("custom_components.lxp_modbus.force_charge.async_call_later", return_value=MagicMock()) as call_later:
+            await session.async_resume(datetime(2024, 1, 1, 12, 30))
+
+        assert session.active
+        assert call_later.call_args[0][1] == 1800
+        assert len(coordinator.listeners) == 1
+        api_client.async_write_registers.assert_not_awaited()
+
+    @pytest.mark.asyncio
+    async def test_resume_ignores_snapshot_soc(self, mock_hass, coordinator, api_client, store):
+        """Test that a restored or cached SOC at the target does not end a resumed charge."""
+        store.async_load.return_value = {
+            "target_soc": 95, "duration": 60, "charge_current": None, "deadline": "2024-01-01T13:00:00",
+            "previous": {"21": 0x0001, "67": 100}, "masks": {"21": 0x80, "120": 0b1110}}
+        coordinator.data["input"][I_SOC_SOH] = (100 << 8) | 96
+        api_client.data_is_stale = True
+        api_client.last_poll_live_tiers = frozenset()
+
+        session = await ForceChargeSession.async_load(mock_hass, "entry1", coordinator, api_client)
+        with patch("custom_components.lxp_modbus.force_charge.async_call_later", return_value=MagicMock()):
+            await session.async_resume(datetime(2024, 1, 1, 12, 30))
+        await asyncio.sleep(0.01)
+        assert session.active
+
+        # A poll that fell back to cached data does not count either
+        api_client.data_is_stale = False
+        for listener in list(coordinator.listeners):
+            listener()
+        await asyncio.sleep(0.01)
+        assert session.active
+        api_client.async_write_registers.assert_not_awaited()
+
+        api_client.last_poll_live_tiers = frozenset({TIER_FAST})
+        for listener in list(coordinator.listeners):
+            listener()
+        await asyncio.sleep(0.01)
+        assert not session.active
+        api_client.async_write_registers.assert_awaited_once()
+
+    @pytest.mark.asyncio
+    async def test_resume_past_deadline_restores(self, mock_hass, coordinator, api_client, store):
+        """Test that a session whose deadline passed during the restart is restored at once."""
+        store.async_load.return_value = {
+            "target_soc": 95, "duration": 60, "charge_current": None, "deadline": "2024-01-01T13:00:00",
+            "previous": {"21": 0x0001, "67": 100}, "masks": {"21": 0x80, "120": 0b1110}}
+
+        session = await ForceChargeSession.async_load(mock_hass, "entry1", coordinator, api_client)
+        await session.async_resume(datetime(2024, 1, 1, 13, 0) + timedelta(minutes=5))
+
+        restore_values, restore_masks = api_client.async_write_registers.await_args[0]
+        assert restore_values == {21: 0x0001, 67: 100}
+        assert restore_masks == {21: 0x80}
+        assert not session.active
+        store.async_remove.assert_awaited_once()
+
+    @pytest.mark.asyncio
+    async def test_nothing_to_resume(self, mock_hass, coordinator, api_client, store):
+        """Test that no session is loaded without persisted state."""
+        assert await ForceChargeSession.async_load(mock_hass, "entry1", coordinator, api_client) is None
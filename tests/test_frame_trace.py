@@ -0,0 +1,91 @@
+"""Tests for the FrameTrace class."""
+
+import pytest
+from unittest.mock import MagicMock
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.frame_trace import DIRECTION_RX, DIRECTION_TX, FrameTrace
+from custom_components.lxp_modbus.classes.lxp_packet_utils import LxpPacketUtils
+from custom_components.lxp_modbus.classes.lxp_request_builder import LxpRequestBuilder
+
+
+def _read_response(register: int, value: bytes) -> bytes:
+    """Build a translated data response of an input register read."""
+    data_frame = bytes([1, 4]) + b"4434280298" + register.to_bytes(2, 'little') + bytes([len(value)]) + value
+    frame = (LxpRequestBuilder.PREFIX + (2).to_bytes(2, 'little') + (len(data_frame) + 16).to_bytes(2, 'little')
+             + bytes([1, LxpRequestBuilder.TRANSLATED_DATA]) + b"DG44302247" + len(data_frame).to_bytes(2, 'little'))
+    return frame + data_frame + LxpPacketUtils.compute_crc(data_frame).to_bytes(2, 'little')
+
+
+class TestFrameTrace:
+    """Test cases for FrameTrace."""
+
+    def test_keeps_most_recent_frames(self):
+        """Test that the trace drops the oldest frames once full."""
+        trace = FrameTrace(size=3)
+        for value in range(5):
+            trace.record(DIRECTION_TX, bytes([value]))
+
+        assert len(trace) == 3
+        assert [frame["frame"] for frame in trace.dump()] == ["02", "03", "04"]
+
+    def test_dump_format(self):
+        """Test that dumped frames carry time, direction, length, hex bytes and notes."""
+        trace = FrameTrace(clock=MagicMock(return_value=1700000000.5))
+        trace.record(DIRECTION_RX, b"\xa1\x1a", "discarded start data")
+        trace.record(DIRECTION_RX, None)
+
+        assert trace.dump() == [
+            {"time": 1700000000.5, "direction": "rx", "length": 2, "frame": "a11a", "note": "discarded start data"},
+            {"time": 1700000000.5, "direction": "rx", "length": 0, "frame": ""},
+        ]
+
+    def test_dump_masks_serials(self):
+        """Test that the masked dump hides the dongle and inverter serials of every packet in a frame."""
+        trace = FrameTrace()
+        request = LxpRequestBuilder.prepare_packet_for_read(b"DG44302247", b"4434280298", 0, 40, 4)
+        trace.record(DIRECTION_TX, request)
+        trace.record(DIRECTION_RX, request + request)
+
+        plain, masked = trace.dump(), trace.dump(mask_serials=True)
+        assert b"DG44302247".hex() in plain[0]["frame"]
+        for entry in masked:
+            frame = entry["frame"]
+            assert b"DG44302247".hex() not in frame and b"4434280298".hex() not in frame
+            assert len(frame) == 2 * entry["length"]
+        assert masked[0]["frame"][:16] == request[:8].hex()
+        assert masked[0]["frame"][16:36] == "*" * 20
+        assert masked[0]["frame"][36:44] == request[18:22].hex()
+        assert masked[0]["frame"][44:64] == "*" * 20
+        assert masked[0]["frame"][64:] == request[32:].hex()
+        assert masked[1]["frame"] == masked[0]["frame"] * 2
+
+    def test_dump_masks_battery_serials(self):
+        """Test that the masked dump hides the serial of every pack in a battery page response."""
+        packs = [bytes(38) + serial.ljust(22, b"\x00") for serial in (b"BAT0012345", b"BAT0067890")]
+        response = _read_response(5030, b"".join(packs))
+        trace = FrameTrace()
+        trace.record(DIRECTION_RX, response)
+
+        frame = trace.dump(mask_serials=True)[0]["frame"]
+        assert b"BAT0012345".hex() not in frame and b"BAT0067890".hex() not in frame
+        assert b"BAT0012345".hex() in trace.dump()[0]["frame"]
+        # Only the serial registers of each pack are masked
+        value = 2 * 35
+        assert frame[value:value + 76] == "00" * 38
+        assert frame[value + 76:value + 108] == "*" * 32
+        assert frame[value + 108:value + 120] == "00" * 6
+        assert frame[-4:] == response[-2:].hex()
+
+    def test_dump_keeps_other_input_reads(self):
+        """Test that responses below the battery range keep their values."""
+        response = _read_response(0, b"BAT0012345" + bytes(50))
+        trace = FrameTrace()
+        trace.record(DIRECTION_RX, response)
+
+        assert b"BAT0012345".hex() in trace.dump(mask_serials=True)[0]["frame"]
+
@@ -0,0 +1,192 @@
+"""Tests for the ParallelGroup class."""
+
+import pytest
+from unittest.mock import AsyncMock, MagicMock
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.group import ParallelGroup
+from custom_components.lxp_modbus.sensor import ModbusBridgeGroupSensor
+from custom_components.lxp_modbus.entity_descriptions.sensor_types import GROUP_SENSOR_TYPES
+from custom_components.lxp_modbus.constants.input_registers import (
+    I_PPV1, I_PPV2, I_PPV3, I_PTOGRID, I_PTOGRID_L1N, I_PTOGRID_L2N, I_PTOGRID_S, I_PTOUSER, I_PTOUSER_L1N,
+    I_SOC_SOH, I_VAC_S, I_VPV3,
+)
+
+
+class TestParallelGroup:
+    """Test cases for ParallelGroup."""
+
+    @pytest.fixture
+    def clock(self):
+        clock = MagicMock(return_value=1000.0)
+        return clock
+
+    @pytest.fixture
+    def group(self, clock):
+        group = ParallelGroup("system", clock=clock)
+        group.add_member("a", MagicMock(poll_interval=10))
+        group.add_member("b", MagicMock(poll_interval=30))
+        return group
+
+    def test_cycles_follow_shortest_interval(self, group, clock):
+        """Test that cycle boundaries are multiples of the shortest member interval."""
+        assert group.period == 10
+        clock.return_value = 1003.0
+        assert group.seconds_to_next_cycle() == pytest.approx(7)
+        assert group.cycle_of_read(1019.6) == 102
+        assert group.cycle_of_read(1024.0) == 102
+        assert group.cycle_of_read(1025.5) is None
+
+    def test_only_complete_cycles_are_published(self, group):
+        """Test that listeners see a cycle once every member has a snapshot of it."""
+        listener = MagicMock()
+        group.async_add_listener(listener)
+
+        group.record("a", 100, {26: 500})
+        listener.assert_not_called()
+        assert group.snapshots() == {}
+
+        group.record("b", 100, {26: 300})
+        listener.assert_called_once()
+        assert group.snapshots() == {"a": {26: 500}, "b": {26: 300}}
+
+        # A member's next cycle does not disturb the published one
+        group.record("a", 101, {26: 900})
+        assert group.snapshots()["a"] == {26: 500}
+
+    def test_missed_cycle_is_counted(self, group):
+        """Test that a cycle one member missed is never published."""
+        listener = MagicMock()
+        group.async_add_listener(listener)
+
+        group.record("a", 100, {})
+        group.record("a", 101, {})
+        group.record("b", 101, {})
+
+        assert group.incomplete_cycles == 1
+        assert group.completed_cycle == 101
+        listener.assert_called_once()
+
+    def test_group_goes_stale_without_complete_cycles(self, group, clock):
+        """Test that the group is current only within GROUP_STALE_CYCLES periods of a complete cycle."""
+        assert group.is_current is False
+
+        group.record("a", 100, {})
+        group.record("b", 100, {})
+        assert group.is_current is True
+
+        clock.return_value = 1030.0
+        assert group.is_current is True
+        clock.return_value = 1030.5
+        assert group.is_current is False
+
+    def test_group_registers_are_pinned_to_fast_tier(self, clock):
+        """Test that members read the group's registers on every fast poll while they belong to it."""
+        group = ParallelGroup("system", registers=[170, 220], clock=clock)
+        member = MagicMock(poll_interval=10)
+
+        group.add_member("a", member)
+        member.api_client.pin_fast_registers.assert_called_once_with("parallel_group", frozenset({170, 220}))
+
+        group.remove_member("a")
+        member.api_client.unpin_fast_registers.assert_called_once_with("parallel_group")
+
+    def test_entities_move_to_next_host_on_unload(self, group):
+        """Test that the group's entities are created once and re-created by the next member when the host leaves."""
+        create_a, create_b = MagicMock(), MagicMock()
+
+        group.async_offer_entity_host("a", create_a)
+        group.async_offer_entity_host("b", create_b)
+        assert group.entity_host == "a"
+        create_a.assert_called_once()
+        create_b.assert_not_called()
+
+        group.remove_member("a")
+        assert group.entity_host == "b"
+        create_b.assert_called_once()
+
+        group.remove_member("b")
+        assert group.entity_host is None
+
+    @pytest.mark.asyncio
+    async def test_broadcast_write_reports_every_member(self, group):
+        """Test that a member raising does not hide the results of the others."""
+        ok = {"success": True, "changed": [64], "unchanged": [], "failed": [], "rolled_back": False, "previous": {64: 100}}
+        group.members["a"].api_client.async_write_registers = AsyncMock(return_value=ok)
+        group.members["b"].api_client.async_write_registers = AsyncMock(side_effect=ConnectionError("down"))
+
+        results = await group.async_broadcast_write({64: 80})
+
+        group.members["a"].api_client.async_write_registers.assert_awaited_once_with({64: 80}, None)
+        assert results["a"] is ok
+        assert results["b"]["success"] is False
+        assert results["b"]["failed"] == [64]
+
+
+class TestGroupSensor:
+    """Test cases for the parallel group sensor entity."""
+
+    @pytest.mark.asyncio
+    async def test_available_again_after_gap_with_unchanged_inputs(self):
+        """Test that a complete cycle after a stale gap writes the state even if no input changed."""
+        clock = MagicMock(return_value=1000.0)
+        group = ParallelGroup("system", clock=clock)
+        group.add_member("a", MagicMock(poll_interval=10))
+        desc = next(desc for desc in GROUP_SENSOR_TYPES if desc["key"] == "pv_power")
+        sensor = ModbusBridgeGroupSensor(group, MagicMock(), MagicMock(), desc)
+        sensor.async_on_remove = MagicMock()
+        sensor.async_write_ha_state = MagicMock()
+
+        group.record("a", 100, {I_PPV1: 500})
+        await sensor.async_added_to_hass()
+        group.async_add_listener(sensor._handle_cycle)
+        assert sensor.available is True
+
+        # No complete cycle for more than GROUP_STALE_CYCLES periods
+        clock.return_value = 1031.0
+        sensor._handle_poll()
+        assert sensor.available is False
+        sensor.async_write_ha_state.assert_called_once()
+
+        group.record("a", 104, {I_PPV1: 500})
+        assert sensor.available is True
+        assert sensor.async_write_ha_state.call_count == 2
+
+        # A later poll sees no change in availability
+        sensor._handle_poll()
+        assert sensor.async_write_ha_state.call_count == 2
+
+
+class TestGroupSensorTypes:
+    """Test cases for the parallel group sensor descriptions."""
+
+    def test_totals_and_average(self):
+        """Test that powers are summed over members and phases and the SOC is averaged."""
+        extract = {desc["key"]: desc["extract"] for desc in GROUP_SENSOR_TYPES}
+        members = {
+            "a": {I_PPV1: 1000, I_PPV2: 500, I_PTOGRID: 200, I_SOC_SOH: (99 << 8) | 80},
+            "b": {I_PPV1: 700, I_PTOGRID_S: 100, I_VAC_S: 2300, I_SOC_SOH: (98 << 8) | 61},
+        }
+
+        assert extract["pv_power"](members, None) == 2200
+        assert extract["grid_export_power"](members, None) == 300
+        assert extract["battery_soc"](members, None) == 70
+        assert extract["battery_soc"]({"a": {}}, None) is None
+
+    def test_totals_count_each_watt_once(self):
+        """Test that split-phase legs and a PV total in I_PPV3 are not added on top of the totals."""
+        extract = {desc["key"]: desc["extract"] for desc in GROUP_SENSOR_TYPES}
+        members = {
+            # US split-phase model: the L1N/L2N legs break down I_PTOGRID/I_PTOUSER
+            "a": {I_PTOGRID: 300, I_PTOGRID_L1N: 150, I_PTOGRID_L2N: 150, I_PTOUSER: 40, I_PTOUSER_L1N: 40},
+            # No third PV input: I_PPV3 reports the total PV power
+            "b": {I_PPV1: 700, I_PPV2: 500, I_PPV3: 1200, I_VPV3: 0},
+        }
+
+        assert extract["grid_export_power"](members, None) == 300
+        assert extract["grid_import_power"](members, None) == 40
+        assert extract["pv_power"](members, None) == 1200
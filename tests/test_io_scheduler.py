@@ -0,0 +1,93 @@
+"""Tests for the IoScheduler class."""
+
+import asyncio
+import pytest
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.io_scheduler import PRIORITY_POLL, PRIORITY_WRITE, IoScheduler
+from custom_components.lxp_modbus.const import IO_THROUGHPUT_WINDOW
+
+
+class TestIoScheduler:
+    """Test cases for IoScheduler."""
+
+    @pytest.mark.asyncio
+    async def test_limits_concurrency_and_admits_writes_first(self):
+        """Test that queued writes overtake queued polls once a slot frees up."""
+        scheduler = IoScheduler(max_concurrent=1)
+        order = []
+        release = asyncio.Event()
+
+        async def operation(name, priority, hold=None):
+            async with scheduler.slot(priority):
+                order.append(name)
+                if hold:
+                    await hold.wait()
+
+        first = asyncio.create_task(operation("poll 1", PRIORITY_POLL, release))
+        await asyncio.sleep(0)
+        queued = [asyncio.create_task(operation(name, priority)) for name, priority in
+                  (("poll 2", PRIORITY_POLL), ("write", PRIORITY_WRITE), ("poll 3", PRIORITY_POLL))]
+        await asyncio.sleep(0)
+
+        stats = scheduler.get_stats()
+        assert stats["in_flight"] == 1
+        assert stats["queue_depth"] == 3
+        assert stats["queued_writes"] == 1
+
+        release.set()
+        await asyncio.gather(first, *queued)
+        assert order == ["poll 1", "write", "poll 2", "poll 3"]
+
+        stats = scheduler.get_stats()
+        assert stats["in_flight"] == 0
+        assert stats["operations"] == 4
+        assert stats["max_queue_depth"] == 3
+
+    @pytest.mark.asyncio
+    async def test_cancelled_waiter_leaves_queue(self):
+        """Test that a cancelled waiter neither blocks the queue nor leaks a slot."""
+        scheduler = IoScheduler(max_concurrent=1)
+        release = asyncio.Event()
+
+        async def hold():
+            async with scheduler.slot(PRIORITY_POLL):
+                await release.wait()
+
+        holder = asyncio.create_task(hold())
+        await asyncio.sleep(0)
+        waiter = asyncio.create_task(hold())
+        await asyncio.sleep(0)
+        waiter.cancel()
+        await asyncio.sleep(0)
+        assert scheduler.get_stats()["queue_depth"] == 0
+
+        release.set()
+        await holder
+        assert scheduler.get_stats()["in_flight"] == 0
+
+    @pytest.mark.asyncio
+    async def test_throughput_window_bounded_without_stats(self):
+        """Test that completion times are dropped as operations finish, not only when stats are read."""
+        now = [0.0]
+        scheduler = IoScheduler(clock=lambda: now[0])
+        for _ in range(1000):
+            async with scheduler.slot():
+                pass
+            now[0] += 1
+
+        assert len(scheduler._completed) == IO_THROUGHPUT_WINDOW + 1
+        assert scheduler.get_stats()["operations"] == 1000
+
+    def test_staggers_first_polls(self):
+        """Test that each entry gets a later first-poll slot, stable across calls."""
+        scheduler = IoScheduler(stagger=2)
+        assert scheduler.register("a") == 0
+        assert scheduler.register("b") == 2
+        assert scheduler.register("a") == 0
+        scheduler.unregister("a")
+        assert scheduler.register("c") == 2
@@ -0,0 +1,44 @@
+"""Tests for the LatencyHistogram class."""
+
+import pytest
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.latency_histogram import LatencyHistogram
+
+
+class TestLatencyHistogram:
+    """Test cases for LatencyHistogram."""
+
+    def test_empty_histogram(self):
+        """Test that an empty histogram reports no percentiles."""
+        stats = LatencyHistogram().get_stats()
+        assert stats == {"count": 0, "p50": None, "p95": None, "p99": None, "max": None}
+
+    def test_percentiles_within_one_bucket(self):
+        """Test that percentiles are estimated within the bucket resolution."""
+        histogram = LatencyHistogram()
+        for _ in range(90):
+            histogram.record(0.1)
+        for _ in range(9):
+            histogram.record(0.8)
+        histogram.record(3.0)
+
+        stats = histogram.get_stats()
+        assert stats["count"] == 100
+        assert stats["p50"] == pytest.approx(100, rel=0.2)
+        assert stats["p95"] == pytest.approx(800, rel=0.2)
+        assert stats["p99"] == pytest.approx(800, rel=0.2)
+        assert stats["max"] == 3000
+
+    def test_memory_is_fixed(self):
+        """Test that the bucket count does not grow with samples or outliers."""
+        histogram = LatencyHistogram()
+        buckets = len(histogram._counts)
+        for seconds in (0, 0.0001, 5, 120, 3600):
+            histogram.record(seconds)
+        assert len(histogram._counts) == buckets
+        assert histogram.percentile(1.0) == 3600000
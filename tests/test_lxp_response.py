@@ -2,6 +2,7 @@
 
 import asyncio
 import pytest
+from unittest.mock import MagicMock
 
 # Import the module under test
 import sys
@@ -9,6 +10,8 @@ import os
 sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
 
 from custom_components.lxp_modbus.classes.lxp_response import LxpResponse
+from custom_components.lxp_modbus.classes.lxp_batteries import LxpBatteries
+from custom_components.lxp_modbus.classes.lxp_request_builder import LxpRequestBuilder
 from test_data import EXCEPTION_RESPONSES, FUNCTION_193_MESSAGE
 
 class TestLxpResponse:
@@ -38,3 +41,44 @@ class TestLxpResponse:
         assert response.dongle_serial == b"DG99999999"
         assert len(response.value)
 
+    def test_write_multi_request_frame(self):
+        """Test that a write-multiple request is a well-formed frame with a valid CRC."""
+        packet = LxpRequestBuilder.prepare_packet_for_write_multi(b"DG99999999", b"99999T9999", 66, [100, 90, 0xFFFF])
+        response = LxpResponse(packet)
+
+        assert response.packet_error is False
+        assert len(packet) == response.packet_length_calced
+        assert response.device_function == LxpRequestBuilder.WRITE_MULTI
+        assert response.serial_number == b"99999T9999"
+        assert response.register == 66
+        # Register count, byte count and the little-endian values follow the start register
+        assert packet[34:37] == bytes([3, 0, 6])
+        assert packet[37:43] == bytes([100, 0, 90, 0, 0xFF, 0xFF])
+
+
+def _battery_response(start: int, serials: list) -> MagicMock:
+    """Build a battery range response of one 30-register block per serial, voltage at offset 8."""
+    value = b""
+    for index, serial in enumerate(serials):
+        block = bytearray(60)
+        block[16:18] = (520 + index).to_bytes(2, "little")
+        block[38:38 + len(serial)] = serial.encode()
+        value += bytes(block)
+    parsed = {start + i: int.from_bytes(value[i * 2:i * 2 + 2], "little") for i in range(len(value) // 2)}
+    return MagicMock(register=start, value=value, parsed_values_dictionary=parsed)
+
+
+class TestLxpBatteries:
+    """Test cases for LxpBatteries."""
+
+    def test_page_past_fourth_pack_is_decoded(self):
+        """Test that a page starting on a later pack boundary decodes each of its packs."""
+        batteries = LxpBatteries(_battery_response(5120, ["BAT0000005", "BAT0000006"])).get_battery_info()
+
+        assert list(batteries) == ["BAT0000005", "BAT0000006"]
+        assert batteries["BAT0000006"][8] == 521
+        assert 19 not in batteries["BAT0000005"]
+
+    def test_unaligned_page_is_ignored(self):
+        """Test that a response not starting on a pack boundary is not decoded."""
+        assert LxpBatteries(_battery_response(5040, ["BAT0000001"])).get_battery_info() == {}
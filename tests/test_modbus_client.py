@@ -13,12 +13,14 @@ import os
 sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
 
 from custom_components.lxp_modbus.classes.modbus_client import LxpModbusApiClient, HOLD_TIME_REGISTERS
+from custom_components.lxp_modbus.classes.circuit_breaker import DongleCircuitBreaker
 from custom_components.lxp_modbus.classes.data_validator import is_data_sane
+from custom_components.lxp_modbus.classes.io_scheduler import PRIORITY_POLL, PRIORITY_WRITE, PrioritySemaphore
 from custom_components.lxp_modbus.classes.lxp_response import LxpResponse
 from custom_components.lxp_modbus.classes.lxp_request_builder import LxpRequestBuilder
 from custom_components.lxp_modbus.const import (
     DEFAULT_CONNECTION_RETRIES, TOTAL_REGISTERS, RESPONSE_OVERHEAD, 
-    WRITE_RESPONSE_LENGTH, MAX_PACKET_RECOVERY_ATTEMPTS, PACKET_RECOVERY_TIMEOUT
+    WRITE_RESPONSE_LENGTH, MAX_PACKET_RECOVERY_ATTEMPTS, PACKET_RECOVERY_TIMEOUT, TIER_FAST, BATTERY_EMPTY_PAGE_READS
 )
 from custom_components.lxp_modbus.constants.hold_registers import H_AC_CHARGE_START_TIME, H_AC_CHARGE_END_TIME
 
@@ -30,11 +32,8 @@ class TestLxpModbusApiClient:
 
     @pytest.fixture
     def mock_lock(self):
-        """Mock asyncio lock."""
-        lock = AsyncMock()
-        lock.__aenter__ = AsyncMock(return_value=None)
-        lock.__aexit__ = AsyncMock(return_value=None)
-        return lock
+        """Dongle lock of a session."""
+        return PrioritySemaphore()
 
     @pytest.fixture
     def client(self, mock_lock):
@@ -115,6 +114,27 @@ class TestLxpModbusApiClient:
         assert client._block_size == 40
         assert client._connection_retries == 5
 
+    def test_reconfigure(self, client):
+        """Test that polling parameters are applied to the live client."""
+        client.reconfigure(block_size=40, connection_retries=5, poll_budget=8.0, write_debounce=0.25)
+
+        assert client._block_size == 40
+        assert client.poll_scheduler.plan[1].start == 40
+        assert client.poll_scheduler.budget == 8.0
+        assert client._connection_retries == 5
+        assert client.circuit_breaker.failure_threshold == 5
+        assert client._write_debounce == 0.25
+
+    def test_reconfigure_leaves_shared_breaker_alone(self, mock_lock):
+        """Test that a breaker shared through the dongle session is not changed by one client."""
+        breaker = DongleCircuitBreaker(3)
+        client = LxpModbusApiClient("192.168.1.100", 8000, "DG44302247", "4434280298", mock_lock,
+                                    connection_retries=3, circuit_breaker=breaker)
+        client.reconfigure(connection_retries=7)
+
+        assert client._connection_retries == 7
+        assert breaker.failure_threshold == 3
+
     def test_get_recovery_stats_initial(self, client):
         """Test recovery statistics when no recoveries have been attempted."""
         stats = client.get_recovery_stats()
@@ -200,6 +220,19 @@ class TestLxpModbusApiClient:
                 assert isinstance(result, dict)
                 assert len(result) > 0
 
+    @pytest.mark.asyncio
+    async def test_async_request_registers_traces_frames(self, client, mock_reader_writer, sample_input_response):
+        """Test that the request and response frames are kept in the trace."""
+        reader, writer = mock_reader_writer
+        reader.read.return_value = sample_input_response
+
+        await client.async_request_registers(writer, reader, 0, "input", 4)
+
+        frames = client.frame_trace.dump()
+        assert [frame["direction"] for frame in frames] == ["tx", "rx"]
+        assert frames[0]["frame"] == writer.write.call_args[0][0].hex()
+        assert frames[1]["frame"] == sample_input_response.hex()
+
     @pytest.mark.asyncio
     async def test_async_request_registers_timeout(self, client, mock_reader_writer):
         """Test register request with timeout."""
@@ -307,6 +340,266 @@ class TestLxpModbusApiClient:
             assert isinstance(result["hold"], dict)
             assert isinstance(result["battery"], dict)
 
+    @pytest.mark.asyncio
+    async def test_async_get_data_fast_tier_only(self, client, mock_reader_writer):
+        """Test that a fast-tier poll only requests the fast input blocks."""
+        reader, writer = mock_reader_writer
+        client._last_good_hold_regs = {0: 300}
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(return_value={0: 12})) as mock_request:
+                result = await client.async_get_data(tiers=(TIER_FAST,))
+
+        mock_request.assert_called_once()
+        assert mock_request.call_args[0][2:5] == (0, "input", 4)
+        assert result["input"] == {0: 12}
+        assert result["hold"] == {0: 300}
+
+    @pytest.mark.asyncio
+    async def test_async_get_data_reads_pinned_registers_live(self, client, mock_reader_writer):
+        """Test that a fast-tier poll reads pinned registers and reports them as live fast-tier inputs."""
+        reader, writer = mock_reader_writer
+        client.pin_fast_registers("consumer", [184, 185])
+
+        async def request(writer, reader, start, request_type, function_code, count):
+            return {register: register for register in range(start, start + min(count, 3))}
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', side_effect=request) as mock_request:
+                await client.async_get_data(tiers=(TIER_FAST,))
+
+        assert [call[0][2] for call in mock_request.call_args_list] == [0, 184]
+        assert client.last_fast_tier_inputs == {0: 0, 1: 1, 2: 2, 184: 184, 185: 185}
+        assert client.last_fast_tier_read is not None
+
+        client.reconfigure(block_size=40)
+        assert client.poll_scheduler.pinned == {"consumer": frozenset({184, 185})}
+
+    @pytest.mark.asyncio
+    async def test_async_get_data_budget_rotates_slow_blocks(self, client, mock_reader_writer):
+        """Test that a tight poll budget reads the fast block every cycle and rotates the rest."""
+        reader, writer = mock_reader_writer
+        client.poll_scheduler.budget = 1.2
+
+        polled = []
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(return_value={0: 1})) as mock_request:
+                for _ in range(6):
+                    mock_request.reset_mock()
+                    await client.async_get_data()
+                    polled.append([c[0][2:4] for c in mock_request.call_args_list])
+
+        # Unread blocks are assumed to take 0.5s: the fast block and one slow block fit
+        assert polled[0] == [(0, "input"), (125, "input")]
+        for cycle in polled:
+            assert cycle[0] == (0, "input")
+        assert len({block for cycle in polled for block in cycle}) == 12
+
+        stats = client.get_diagnostics()["poll_scheduler"]
+        assert stats["cycles"] == 6
+        assert stats["overruns"] == 0
+        assert stats["max_rotation_lag"] < 6
+
+    @pytest.mark.asyncio
+    async def test_restored_snapshot_stale_until_live_poll(self, client, mock_reader_writer):
+        """Test that snapshot data is served as stale until a live poll replaces it."""
+        reader, writer = mock_reader_writer
+        data = client.restore_snapshot({"input": {0: 4, 1: 10}, "hold": {0: 300}, "battery": {}})
+        assert data["input"] == {0: 4, 1: 10}
+        assert client.data_is_stale is True
+
+        # A failed poll falls back to the snapshot and keeps it marked stale
+        with patch('asyncio.open_connection', side_effect=ConnectionRefusedError("Connection refused")):
+            result = await client.async_get_data()
+        assert result["hold"] == {0: 300}
+        assert client.data_is_stale is True
+        assert client.last_poll_live is False
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(return_value={0: 12})):
+                result = await client.async_get_data()
+        assert result["input"] == {0: 12, 1: 10}
+        assert client.data_is_stale is False
+        assert client.last_poll_live is True
+
+    @pytest.mark.asyncio
+    async def test_last_poll_live_tiers(self, client, mock_reader_writer):
+        """Test that a tier counts as live only when all of its blocks were read."""
+        reader, writer = mock_reader_writer
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(return_value={0: 12})):
+                await client.async_get_data(tiers=(TIER_FAST,))
+            assert client.last_poll_live_tiers == {TIER_FAST}
+
+            # The fast block times out: nothing of this poll is live, even if other blocks were read
+            with patch.object(client, 'async_request_registers', AsyncMock(side_effect=asyncio.TimeoutError)):
+                await client.async_get_data()
+            assert client.last_poll_live_tiers == frozenset()
+
+            with patch.object(client, 'async_request_registers', AsyncMock(return_value={})):
+                await client.async_get_data(tiers=(TIER_FAST,))
+            assert client.last_poll_live_tiers == frozenset()
+
+    @pytest.mark.asyncio
+    async def test_async_get_data_reports_each_block(self, client, mock_reader_writer):
+        """Test that on_block sees the dataset grow as blocks arrive."""
+        reader, writer = mock_reader_writer
+        sizes = []
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(side_effect=lambda *a: {a[2]: a[2]})):
+                result = await client.async_get_data(
+                    on_block=lambda data: sizes.append((len(data["input"]), len(data["hold"]))))
+
+        assert sizes[0] == (1, 0)
+        assert sizes[-1] == (6, 6)
+        assert len(sizes) == 12
+        assert result is not None and len(result["input"]) == 6
+
+    @pytest.mark.asyncio
+    async def test_battery_polling_has_own_schedule_and_failure_domain(self, client, mock_reader_writer):
+        """Test that a battery timeout spares the hold registers and read pages wait for their interval."""
+        reader, writer = mock_reader_writer
+        client._request_battery_data = True
+        battery_timeouts = [True, False]
+
+        async def request(writer, reader, reg, request_type, function_code, count=None):
+            if request_type == "input/bat":
+                if battery_timeouts.pop(0):
+                    raise asyncio.TimeoutError
+                return {"BAT0000001": {"serial": "BAT0000001", 8: 520}}
+            return {96: 1} if request_type == "input" and reg == 0 else {reg: 1}
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(side_effect=request)) as mock_request:
+                result = await client.async_get_data()
+                assert len(result["hold"]) == 6
+                assert result["battery"] == {}
+                assert client.battery_is_fresh("BAT0000001") is False
+
+                # The timed out page is retried on the next poll
+                result = await client.async_get_data()
+                assert result["battery"]["BAT0000001"][8] == 520
+                assert client.battery_is_fresh("BAT0000001") is True
+
+                mock_request.reset_mock()
+                await client.async_get_data()
+                assert all(c[0][3] != "input/bat" for c in mock_request.call_args_list)
+
+        assert client.get_diagnostics()["batteries"]["timeouts"] == 1
+
+    @pytest.mark.asyncio
+    async def test_battery_change_reported_once(self, client, mock_reader_writer):
+        """Test that packs are reported only when they appear or disappear, including restored ones."""
+        reader, writer = mock_reader_writer
+        client._request_battery_data = True
+        client.restore_snapshot({"input": {0: 4}, "hold": {0: 300}, "battery": {"BAT0000009": {8: 500}}})
+        client.on_battery_change = MagicMock()
+        client._battery_schedule._interval = 0
+
+        async def request(writer, reader, reg, request_type, function_code, count=None):
+            if request_type == "input/bat":
+                return {"BAT0000001": {"serial": "BAT0000001", 8: 520}}
+            return {96: 1} if request_type == "input" and reg == 0 else {reg: 1}
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(side_effect=request)):
+                result = await client.async_get_data()
+                client.on_battery_change.assert_called_once_with({"BAT0000001"}, {"BAT0000009"})
+                assert list(result["battery"]) == ["BAT0000001"]
+
+                client.on_battery_change.reset_mock()
+                await client.async_get_data()
+                client.on_battery_change.assert_not_called()
+
+    @pytest.mark.asyncio
+    async def test_battery_count_zero_removes_all_packs(self, client, mock_reader_writer):
+        """Test that a live pack count of 0 reports every known pack as removed without reading pages."""
+        reader, writer = mock_reader_writer
+        client._request_battery_data = True
+        client.restore_snapshot({"input": {0: 4}, "hold": {0: 300}, "battery": {"BAT0000009": {8: 500}}})
+        client.on_battery_change = MagicMock()
+
+        async def request(writer, reader, reg, request_type, function_code, count=None):
+            return {96: 0} if request_type == "input" and reg == 0 else {reg: 1}
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(side_effect=request)) as mock_request:
+                result = await client.async_get_data()
+
+        assert all(c[0][3] != "input/bat" for c in mock_request.call_args_list)
+        client.on_battery_change.assert_called_once_with(set(), {"BAT0000009"})
+        assert result["battery"] == {}
+        assert client.get_diagnostics()["batteries"]["stale"] == []
+
+    @pytest.mark.asyncio
+    async def test_battery_page_without_serial_removes_pack(self, client, mock_reader_writer):
+        """Test that a pack whose page keeps answering without a serial is removed."""
+        reader, writer = mock_reader_writer
+        client._request_battery_data = True
+        client.restore_snapshot({"input": {0: 4}, "hold": {0: 300}, "battery": {"BAT0000009": {8: 500}}})
+        client.on_battery_change = MagicMock()
+
+        async def request(writer, reader, reg, request_type, function_code, count=None):
+            if request_type == "input/bat":
+                return {}
+            return {96: 1} if request_type == "input" and reg == 0 else {reg: 1}
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(side_effect=request)):
+                for _ in range(BATTERY_EMPTY_PAGE_READS - 1):
+                    await client.async_get_data()
+                client.on_battery_change.assert_not_called()
+
+                result = await client.async_get_data()
+
+        client.on_battery_change.assert_called_once_with(set(), {"BAT0000009"})
+        assert result["battery"] == {}
+
+    @pytest.mark.asyncio
+    async def test_write_overtakes_queued_polls_on_one_dongle(self, client):
+        """Test that a write queued behind polls of the same dongle gets the next session."""
+        order = []
+        release = asyncio.Event()
+
+        async def session(name, priority, hold=None):
+            async with client._session(priority):
+                order.append(name)
+                if hold:
+                    await hold.wait()
+
+        first = asyncio.create_task(session("poll 1", PRIORITY_POLL, release))
+        await asyncio.sleep(0)
+        queued = [asyncio.create_task(session(name, priority)) for name, priority in
+                  (("poll 2", PRIORITY_POLL), ("poll 3", PRIORITY_POLL), ("write", PRIORITY_WRITE))]
+        await asyncio.sleep(0)
+        assert order == ["poll 1"]
+
+        release.set()
+        await asyncio.gather(first, *queued)
+        assert order == ["poll 1", "write", "poll 2", "poll 3"]
+
+    @pytest.mark.asyncio
+    async def test_async_read_identity(self, client, mock_reader_writer):
+        """Test that the identity read requests only the firmware hold registers."""
+        reader, writer = mock_reader_writer
+        firmware = {7: 0x4141, 8: 0x4142, 9: 0x0102, 10: 0x0304}
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(return_value=firmware)) as mock_request:
+                assert await client.async_read_identity() == firmware
+
+        assert mock_request.call_args[0][2:] == (7, "hold", 3, 4)
+        assert client.cached_data["hold"] == firmware
+        assert client.cached_data["input"] == {}
+
+    @pytest.mark.asyncio
+    async def test_async_read_identity_failure(self, client):
+        """Test that a failed identity read does not raise."""
+        with patch('asyncio.open_connection', side_effect=ConnectionRefusedError("Connection refused")):
+            assert await client.async_read_identity() == {}
+
     @pytest.mark.asyncio
     async def test_async_get_data_connection_failure(self, client):
         """Test data retrieval with connection failure."""
@@ -342,21 +635,87 @@ class TestLxpModbusApiClient:
 
     @pytest.mark.asyncio
     async def test_async_get_data_connection_retry(self, client, mock_reader_writer, sample_input_response):
-        """Test connection retry logic."""
+        """Test that a failed connection is retried on the next cycle, not inside the locked cycle."""
         reader, writer = mock_reader_writer
         
         # First connection fails, second succeeds
         connection_attempts = [ConnectionRefusedError("Connection refused"), (reader, writer)]
         
-        with patch('asyncio.open_connection', side_effect=connection_attempts):
+        with patch('asyncio.open_connection', side_effect=connection_attempts) as mock_open, \
+                patch('asyncio.sleep', AsyncMock()) as mock_sleep:
             reader.read.return_value = sample_input_response
             
+            result = await client.async_get_data()
+            assert mock_open.call_count == 1
+            assert result == {"input": {}, "hold": {}, "battery": {}}
+
             result = await client.async_get_data()
 
             assert "input" in result
             assert "hold" in result
             assert "battery" in result
             assert client._connection_retry_count > 0
+            mock_sleep.assert_not_called()
+
+    @pytest.mark.asyncio
+    async def test_async_get_data_open_circuit_skips_connection(self, client):
+        """Test that an open circuit returns cached data without touching the network."""
+        client._last_good_input_regs = {0: 100}
+        client._last_good_hold_regs = {0: 300}
+
+        with patch('asyncio.open_connection', side_effect=ConnectionRefusedError("Connection refused")) as mock_open:
+            for _ in range(client._connection_retries):
+                await client.async_get_data()
+            assert client.circuit_breaker.state == "open"
+            assert mock_open.call_count == client._connection_retries
+
+            result = await client.async_get_data()
+
+        assert mock_open.call_count == client._connection_retries
+        assert result["input"] == {0: 100}
+        assert client.get_diagnostics()["circuit_breaker"]["state"] == "open"
+
+    @pytest.mark.asyncio
+    async def test_cancelled_probe_releases_half_open_circuit(self, client):
+        """Test that a probe connect cancelled mid-flight lets the next poll probe again."""
+        breaker = DongleCircuitBreaker(1, base_delay=0, jitter=0)
+        client._circuit_breaker = breaker
+        breaker.record_failure("refused")
+        assert breaker.state == "half_open"
+
+        with patch('asyncio.open_connection', side_effect=asyncio.CancelledError()):
+            with pytest.raises(asyncio.CancelledError):
+                await client.async_get_data()
+
+        assert breaker.state == "half_open"
+        assert breaker.allow_request() is True
+
+    @pytest.mark.asyncio
+    async def test_unexpected_probe_error_reopens_circuit(self, client):
+        """Test that a probe failing with an unexpected exception counts as a failure."""
+        now = [1000.0]
+        breaker = DongleCircuitBreaker(1, base_delay=30, jitter=0, clock=lambda: now[0])
+        client._circuit_breaker = breaker
+        breaker.record_failure("refused")
+        now[0] += 30
+        assert breaker.state == "half_open"
+
+        with patch('asyncio.open_connection', side_effect=RuntimeError("boom")):
+            await client.async_get_data()
+
+        assert breaker.state == "open"
+
+    @pytest.mark.asyncio
+    async def test_async_write_register_open_circuit(self, client):
+        """Test that writes are rejected immediately while the circuit is open."""
+        for _ in range(client._connection_retries):
+            client.circuit_breaker.record_failure("refused")
+
+        with patch('asyncio.open_connection') as mock_open:
+            result = await client.async_write_register(100, 500)
+
+        assert result is False
+        mock_open.assert_not_called()
 
     @pytest.mark.asyncio
     async def test_async_write_register_success(self, client, mock_reader_writer):
@@ -381,6 +740,320 @@ class TestLxpModbusApiClient:
                 writer.write.assert_called_once()
                 writer.drain.assert_called_once()
 
+    @pytest.mark.asyncio
+    async def test_async_write_bits_merges_concurrent_changes(self, client, mock_reader_writer):
+        """Test that concurrent bit changes are applied to a fresh read and written once."""
+        reader, writer = mock_reader_writer
+        reader.read.return_value = b"\xa1\x1a" + b"0" * 74
+        client._bit_writer._window = 0
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(return_value={21: 0b1000_0000})) as mock_read:
+                with patch('custom_components.lxp_modbus.classes.modbus_client.LxpResponse') as mock_response_class:
+                    mock_response = MagicMock()
+                    mock_response.packet_error = False
+                    mock_response.parsed_values_dictionary = {21: 0b1000_0101}
+                    mock_response_class.return_value = mock_response
+
+                    results = await asyncio.gather(
+                        client.async_write_bits(21, 0b001, 0b001),
+                        client.async_write_bits(21, 0b100, 0b100),
+                    )
+
+        assert results == [0b1000_0101, 0b1000_0101]
+        mock_read.assert_called_once()
+        assert mock_read.call_args[0][2:] == (21, "hold", 3, 1)
+        writer.write.assert_called_once()
+        assert client.cached_data["hold"][21] == 0b1000_0101
+        assert client.get_diagnostics()["bitfield_writes"] == {"masked_writes": 1, "batched_changes": 1}
+
+    @pytest.mark.asyncio
+    async def test_async_write_bits_skips_unchanged_register(self, client, mock_reader_writer):
+        """Test that no write is sent when the bits already have the requested value."""
+        reader, writer = mock_reader_writer
+        client._bit_writer._window = 0
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(return_value={21: 0b101})):
+                assert await client.async_write_bits(21, 0b100, 0b100) == 0b101
+
+        writer.write.assert_not_called()
+
+    @pytest.mark.asyncio
+    async def test_async_write_register_skips_confirmed_value(self, client):
+        """Test that a write of a freshly confirmed value is skipped unless forced."""
+        client._confirm_hold_regs({100: 500})
+
+        with patch.object(client, '_async_write_with_retries', AsyncMock(return_value=500)) as mock_write:
+            assert await client.async_write_register(100, 500) is True
+            mock_write.assert_not_called()
+
+            assert await client.async_write_register(100, 500, force=True) is True
+            assert await client.async_write_register(100, 501) is True
+            assert mock_write.await_count == 2
+
+        assert client.get_diagnostics()["skipped_writes"] == 1
+
+    @pytest.mark.asyncio
+    async def test_async_write_register_ignores_unconfirmed_value(self, client):
+        """Test that optimistic cache values and expired confirmations do not skip writes."""
+        client._last_good_hold_regs[100] = 500  # optimistic entity update
+        client._confirmed_hold_regs[101] = (7, time_lib.monotonic() - 1000)  # confirmed long ago
+
+        with patch.object(client, '_async_write_with_retries', AsyncMock(return_value=1)) as mock_write:
+            await client.async_write_register(100, 500)
+            await client.async_write_register(101, 7)
+
+        assert mock_write.await_count == 2
+        assert client.get_diagnostics()["skipped_writes"] == 0
+
+    @pytest.mark.asyncio
+    async def test_async_write_bits_skips_confirmed_bits(self, client):
+        """Test that a bit change already reflected by the confirmed value is skipped."""
+        client._confirm_hold_regs({21: 0b101})
+
+        with patch.object(client._bit_writer, 'async_write_bits', AsyncMock(return_value=0b111)) as mock_bits:
+            assert await client.async_write_bits(21, 0b100, 0b100) == 0b101
+            mock_bits.assert_not_called()
+            assert await client.async_write_bits(21, 0b010, 0b010) == 0b111
+            mock_bits.assert_awaited_once()
+
+    @pytest.mark.asyncio
+    async def test_async_write_debounced_coalesces_values(self, client):
+        """Test that number values set within the debounce window result in one write of the latest."""
+        client._write_debounce = 0.01
+
+        with patch.object(client, '_async_write_with_retries', AsyncMock(return_value=30)) as mock_write:
+            results = await asyncio.gather(
+                client.async_write_debounced(64, 0xFFFF, 10),
+                client.async_write_debounced(64, 0xFFFF, 20),
+                client.async_write_debounced(64, 0xFFFF, 30),
+            )
+
+        mock_write.assert_awaited_once_with(64, 30)
+        assert results == [30, 30, 30]
+
+    @pytest.mark.asyncio
+    async def test_async_write_bits_no_skip_while_busy(self, client):
+        """Test that a value matching the confirmed one is queued while another change is pending."""
+        client._confirm_hold_regs({64: 10})
+        client._write_debounce = 0.01
+
+        with patch.object(client, '_async_write_with_retries', AsyncMock(return_value=10)) as mock_write:
+            results = await asyncio.gather(
+                client.async_write_debounced(64, 0xFFFF, 20),
+                client.async_write_debounced(64, 0xFFFF, 10),
+            )
+
+        # The second value reverts the first, so the pending write must carry it
+        mock_write.assert_awaited_once_with(64, 10)
+        assert results == [10, 10]
+
+    @pytest.mark.asyncio
+    async def test_submit_write_confirmed_by_ack(self, client):
+        """Test that a submitted write is shown at once and confirmed by the write acknowledgement."""
+        client._last_good_hold_regs[21] = 0b100
+        resolved = []
+        client.on_write_resolved = lambda *args: resolved.append(args)
+
+        with patch.object(client._bit_writer, 'async_write_bits', AsyncMock(return_value=0b101)) as mock_bits:
+            assert client.submit_write(21, 0b001, 0b001) == 0b101
+            assert client.cached_data["hold"][21] == 0b101
+            await client.async_wait_for_writes()
+
+        mock_bits.assert_awaited_once_with(21, 0b001, 0b001, window=None)
+        assert resolved == [(21, 0b101, None)]
+        assert client.get_diagnostics()["write_journal"]["confirmed_by_ack"] == 1
+
+    @pytest.mark.asyncio
+    async def test_submit_write_reverts_on_failure(self, client):
+        """Test that a write the inverter never confirms reverts to the last value read from it."""
+        client._last_good_hold_regs[64] = 50
+        client._confirm_hold_regs({64: 40})
+        resolved = []
+        client.on_write_resolved = lambda *args: resolved.append(args)
+
+        with patch.object(client, '_async_write_with_retries', AsyncMock(return_value=None)):
+            assert client.submit_write(64, 0xFFFF, 100, debounce=True) == 100
+            await client.async_wait_for_writes()
+
+        assert client.cached_data["hold"][64] == 40
+        assert resolved == [(64, 100, 40)]
+        assert client.get_diagnostics()["write_journal"]["reverted"] == 1
+
+    @pytest.mark.asyncio
+    async def test_failed_write_keeps_newer_queued_value(self, client):
+        """Test that a failed write does not drop the overlay of a newer write queued behind it."""
+        client._last_good_hold_regs[64] = 50
+        client._confirm_hold_regs({64: 50})
+        resolved = []
+        client.on_write_resolved = lambda *args: resolved.append(args)
+        release_first = asyncio.Event()
+        shown_after_failure = []
+
+        async def write_bits(register, mask, bits, window=None):
+            await release_first.wait()
+            if bits == 100:
+                return None
+            # The newer write is still queued when the first one fails
+            await asyncio.sleep(0.01)
+            shown_after_failure.append(client.cached_data["hold"][64])
+            return bits
+
+        with patch.object(client._bit_writer, 'async_write_bits', side_effect=write_bits):
+            client.submit_write(64, 0xFFFF, 100)
+            await asyncio.sleep(0)
+            assert client.submit_write(64, 0xFFFF, 120) == 120
+            release_first.set()
+            await client.async_wait_for_writes()
+
+        assert shown_after_failure == [120]
+        assert client.cached_data["hold"][64] == 120
+        assert resolved == [(64, 120, None)]
+        assert client.get_diagnostics()["write_journal"]["reverted"] == 0
+
+    @pytest.mark.asyncio
+    async def test_poll_keeps_pending_write_and_confirms_by_read(self, client, mock_reader_writer):
+        """Test that a poll reading the old value keeps the submitted one until a read confirms it."""
+        reader, writer = mock_reader_writer
+        client._last_good_hold_regs[0] = 0b100
+        client._bit_writer.async_write_bits = AsyncMock(side_effect=lambda *args, **kwargs: asyncio.Event().wait())
+        resolved = []
+        client.on_write_resolved = lambda *args: resolved.append(args)
+        client.submit_write(0, 0b001, 0b001)
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)):
+            with patch.object(client, 'async_request_registers', AsyncMock(return_value={0: 0b110})):
+                result = await client.async_get_data()
+            assert result["hold"][0] == 0b111
+            assert resolved == []
+
+            with patch.object(client, 'async_request_registers', AsyncMock(return_value={0: 0b011})):
+                result = await client.async_get_data()
+        assert result["hold"][0] == 0b011
+        assert resolved == [(0, 0b011, None)]
+        assert client.get_diagnostics()["write_journal"]["confirmed_by_read"] == 1
+
+        for task in client._write_tasks:
+            task.cancel()
+
+    @pytest.mark.asyncio
+    async def test_foreign_frame_is_routed(self, client, mock_reader_writer):
+        """Test that a valid frame for another inverter is handed on instead of dropped."""
+        reader, writer = mock_reader_writer
+        reader.read.return_value = b"x" * 300
+        client.on_foreign_frame = MagicMock()
+
+        with patch('custom_components.lxp_modbus.classes.modbus_client.LxpResponse') as mock_response_class:
+            response = mock_response_class.return_value
+            response.packet_error = False
+            response.serial_number = b"9999999999"
+            assert await client.async_request_registers(writer, reader, 0, "input", 4, 2) == {}
+
+        client.on_foreign_frame.assert_called_once_with(response)
+
+    def test_accept_routed_frame_merges_registers(self, client):
+        """Test that routed input and hold frames update the cached data."""
+        client.accept_routed_frame(MagicMock(device_function=4, register=0, parsed_values_dictionary={0: 4, 1: 10}))
+        client.accept_routed_frame(MagicMock(device_function=3, register=64, parsed_values_dictionary={64: 90}))
+        client.accept_routed_frame(MagicMock(device_function=6, register=21, parsed_values_dictionary={21: 1}))
+
+        assert client.cached_data["input"] == {0: 4, 1: 10}
+        assert client.cached_data["hold"] == {64: 90}
+        assert client.confirmed_value(64) == 90
+        assert client.get_diagnostics()["routed_frames"] == 2
+
+    def _fake_inverter(self, client, regs, fail_runs=(), ignore_writes=(), timeout_runs=()):
+        """Patch the session primitives of a register transaction with an in-memory hold register map.
+
+        A run in timeout_runs is applied but its first acknowledgement times out.
+        """
+        writes = []
+        timeout_runs = set(timeout_runs)
+
+        async def read(writer, reader, start, request_type, function_code, count):
+            return {register: regs[register] for register in range(start, start + count) if register in regs}
+
+        async def write_run(writer, reader, start, run):
+            writes.append((start, list(run)))
+            if start in fail_runs:
+                return False
+            for offset, value in enumerate(run):
+                if start + offset not in ignore_writes:
+                    regs[start + offset] = value
+            if start in timeout_runs:
+                timeout_runs.discard(start)
+                raise asyncio.TimeoutError()
+            return True
+
+        return writes, patch.object(client, 'async_request_registers', side_effect=read), \
+            patch.object(client, '_async_write_run', side_effect=write_run)
+
+    @pytest.mark.asyncio
+    async def test_async_write_registers_writes_only_differences(self, client, mock_reader_writer):
+        """Test that a profile writes changed registers in contiguous runs and verifies them."""
+        reader, writer = mock_reader_writer
+        regs = {64: 50, 65: 50, 66: 20, 67: 80, 70: 0}
+        writes, read_patch, write_patch = self._fake_inverter(client, regs)
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)), read_patch, write_patch:
+            result = await client.async_write_registers({64: 100, 65: 100, 66: 20, 67: 90, 70: 1})
+
+        assert result == {"success": True, "changed": [64, 65, 67, 70], "unchanged": [66],
+                          "failed": [], "rolled_back": False, "previous": {64: 50, 65: 50, 67: 80, 70: 0}}
+        # Register 66 is unchanged but rewritten so 64-67 go out in one frame
+        assert writes == [(64, [100, 100, 20, 90]), (70, [1])]
+        assert client.confirmed_value(67) == 90
+        assert client.cached_data["hold"][64] == 100
+        writer.close.assert_called_once()
+
+    @pytest.mark.asyncio
+    async def test_async_write_registers_rolls_back_on_failure(self, client, mock_reader_writer):
+        """Test that a failed write restores every register the profile changed."""
+        reader, writer = mock_reader_writer
+        regs = {64: 50, 65: 50, 70: 0}
+        writes, read_patch, write_patch = self._fake_inverter(client, regs, ignore_writes=(70,))
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)), read_patch, write_patch:
+            result = await client.async_write_registers({64: 100, 65: 100, 70: 1})
+
+        assert result["success"] is False
+        assert result["failed"] == [70]
+        assert result["rolled_back"] is True
+        assert regs == {64: 50, 65: 50, 70: 0}
+        assert writes[-2:] == [(64, [50, 50]), (70, [0])]
+
+    @pytest.mark.asyncio
+    async def test_async_write_registers_rolls_back_on_timeout(self, client, mock_reader_writer):
+        """Test that a run timing out after earlier runs were written still restores every register."""
+        reader, writer = mock_reader_writer
+        regs = {10: 1, 11: 2, 20: 3}
+        writes, read_patch, write_patch = self._fake_inverter(client, regs, timeout_runs=(20,))
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)), read_patch, write_patch:
+            result = await client.async_write_registers({10: 5, 11: 6, 20: 7})
+
+        assert result["success"] is False
+        assert result["failed"] == [10, 11, 20]
+        assert result["rolled_back"] is True
+        assert result["previous"] == {10: 1, 11: 2, 20: 3}
+        assert regs == {10: 1, 11: 2, 20: 3}
+        assert client.confirmed_value(10) == 1
+        writer.close.assert_called_once()
+
+    @pytest.mark.asyncio
+    async def test_async_write_registers_unreadable_target(self, client, mock_reader_writer):
+        """Test that nothing is written when the current values cannot be read."""
+        reader, writer = mock_reader_writer
+        writes, read_patch, write_patch = self._fake_inverter(client, {64: 50})
+
+        with patch('asyncio.open_connection', return_value=(reader, writer)), read_patch, write_patch:
+            result = await client.async_write_registers({64: 100, 65: 100})
+
+        assert result["success"] is False
+        assert result["failed"] == [64, 65]
+        assert writes == []
+
     @pytest.mark.asyncio
     async def test_async_write_register_failure(self, client):
         """Test register write failure."""
@@ -0,0 +1,157 @@
+"""Tests for the PollScheduler class."""
+
+import pytest
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.poll_plan import build_battery_pages, build_poll_plan
+from custom_components.lxp_modbus.classes.poll_scheduler import PollScheduler
+from custom_components.lxp_modbus.const import TIER_FAST
+
+
+def run_cycle(scheduler, tiers=None, duration=1.0, success=True):
+    """Select a cycle and report every selected block as read in `duration` seconds."""
+    blocks = scheduler.select(tiers)
+    for block in blocks:
+        scheduler.record_block(block, duration, success)
+    scheduler.record_cycle(duration * len(blocks))
+    return blocks
+
+
+class TestPollScheduler:
+    """Test cases for PollScheduler."""
+
+    @pytest.fixture
+    def plan(self):
+        return build_poll_plan(125)
+
+    def test_no_budget_reads_everything(self, plan):
+        """Test that without a budget every block is read in plan order."""
+        scheduler = PollScheduler(plan)
+        assert run_cycle(scheduler) == plan
+        assert scheduler.get_stats()["deferred_blocks_last_cycle"] == 0
+
+    def test_tier_filter(self, plan):
+        """Test that a fast-tier cycle only returns fast blocks."""
+        scheduler = PollScheduler(plan, budget=100)
+        blocks = scheduler.select((TIER_FAST,))
+        assert blocks and all(b.tier == TIER_FAST for b in blocks)
+
+    def test_fast_blocks_always_read(self, plan):
+        """Test that fast blocks are read even when they alone exceed the budget."""
+        scheduler = PollScheduler(plan, budget=0.5)
+        for _ in range(3):
+            blocks = run_cycle(scheduler, duration=2.0)
+            assert plan[0] in blocks
+
+    def test_round_robin_rotation(self, plan):
+        """Test that slow blocks rotate so every block is read once before any repeats."""
+        scheduler = PollScheduler(plan, budget=1.6)
+        slow = [b for b in plan if b.tier != TIER_FAST]
+        seen = []
+        for _ in range(4):
+            blocks = run_cycle(scheduler, duration=0.5)
+            assert plan[0] in blocks
+            seen.extend(b for b in blocks if b.tier != TIER_FAST)
+        # 0.5s per block: the fast block and two slow blocks fit into each cycle
+        assert seen == slow[:8]
+        assert scheduler.get_stats()["deferred_blocks_last_cycle"] == len(slow) - 2
+
+    def test_max_lag_forces_block(self, plan):
+        """Test that a block lagging max_lag_cycles is read despite the budget."""
+        scheduler = PollScheduler(plan, budget=1.0, max_lag_cycles=3)
+        for _ in range(6):
+            run_cycle(scheduler)
+            assert scheduler.get_stats()["max_rotation_lag"] < 3
+
+    def test_fast_only_polls_do_not_age_slow_blocks(self, plan):
+        """Test that fast-tier polls between full polls leave the rotation undisturbed."""
+        scheduler = PollScheduler(plan, budget=1.6, max_lag_cycles=10)
+        for _ in range(4):
+            blocks = run_cycle(scheduler, duration=0.5)
+            assert len(blocks) == 3
+            for _ in range(10):
+                run_cycle(scheduler, tiers=(TIER_FAST,), duration=0.5)
+        assert scheduler.get_stats()["cycles"] == 4
+        assert scheduler.get_stats()["max_rotation_lag"] == 4
+
+    def test_pinned_registers_join_fast_polls(self, plan):
+        """Test that pinned registers are read right after the fast blocks, in one block per slow block."""
+        scheduler = PollScheduler(build_poll_plan(40))
+        scheduler.pin("consumer", [26, 170, 184, 187, 220])
+
+        blocks = scheduler.select((TIER_FAST,))
+        extra = [(b.start, b.count) for b in blocks if b.tier == TIER_FAST and b.start >= 125]
+        assert extra == [(170, 18), (220, 1)]
+        assert [b.start for b in blocks] == [0, 40, 80, 120, 170, 220]
+        assert scheduler.is_fast_register(184) and not scheduler.is_fast_register(188)
+
+        # A full poll reads the holding slow blocks instead
+        assert [b.start for b in scheduler.select() if b.register_type == "input"][:7] == [0, 40, 80, 120, 160, 200, 240]
+
+        scheduler.unpin("consumer")
+        assert [b.start for b in scheduler.select((TIER_FAST,))] == [0, 40, 80, 120]
+
+    def test_pinned_block_replaces_deferred_slow_block(self, plan):
+        """Test that a pinned register is still read when the budget defers its slow block."""
+        scheduler = PollScheduler(plan, budget=1.0)
+        scheduler.pin("consumer", [170])
+        blocks = run_cycle(scheduler, duration=0.5)
+        assert [(b.start, b.count) for b in blocks if b.register_type == "input"] == [(0, 125), (170, 1)]
+        assert scheduler.get_stats()["pinned_fast_registers"] == [170]
+
+    def test_failed_block_keeps_lagging(self, plan):
+        """Test that a block that returned nothing is not counted as refreshed."""
+        scheduler = PollScheduler(plan)
+        run_cycle(scheduler, success=False)
+        run_cycle(scheduler, success=False)
+        assert scheduler.lag(plan[-1]) == 2
+
+    def test_learned_read_times(self, plan):
+        """Test that measured read times replace the initial estimate."""
+        scheduler = PollScheduler(plan, budget=10)
+        scheduler.select()
+        scheduler.record_block(plan[1], 2.0, True)
+        assert scheduler.estimate(plan[1]) == 2.0
+        scheduler.record_block(plan[1], 1.0, True)
+        assert 1.0 < scheduler.estimate(plan[1]) < 2.0
+
+    def test_overhead_counts_against_budget(self, plan):
+        """Test that session setup time reduces the room left for slow blocks."""
+        scheduler = PollScheduler(plan, budget=2.0)
+        scheduler.record_overhead(1.5)
+        blocks = scheduler.select()
+        assert blocks == [plan[0]]
+
+    def test_overruns(self, plan):
+        """Test that cycles longer than the budget are counted."""
+        scheduler = PollScheduler(plan, budget=2.0)
+        scheduler.select()
+        scheduler.record_cycle(1.5)
+        scheduler.select()
+        scheduler.record_cycle(2.5)
+        stats = scheduler.get_stats()
+        assert stats["overruns"] == 1
+        assert stats["last_cycle_duration"] == 2.5
+
+
+class TestBatteryPages:
+    """Test cases for paging the battery register range."""
+
+    def test_pages_cover_reported_packs(self):
+        """Test that pages hold as many whole packs as the block size allows."""
+        pages = build_battery_pages(125, 6)
+        assert [(page.start, page.count) for page in pages] == [(5000, 120), (5120, 60)]
+
+    def test_legacy_block_size_reads_one_pack_per_page(self):
+        """Test that a 40-register block size still reads aligned 30-register packs."""
+        pages = build_battery_pages(40, 3)
+        assert [(page.start, page.count) for page in pages] == [(5000, 30), (5030, 30), (5060, 30)]
+
+    def test_implausible_pack_count_is_capped(self):
+        """Test that a garbage pack count does not page through the whole register space."""
+        assert build_battery_pages(125, 0) == []
+        assert sum(page.count for page in build_battery_pages(125, 0xFFFF)) == 32 * 30
@@ -0,0 +1,72 @@
+"""Tests for the RegisterSnapshotStore class."""
+
+import json
+import pytest
+from unittest.mock import AsyncMock, MagicMock, patch
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.register_snapshot import RegisterSnapshotStore
+from custom_components.lxp_modbus.const import SNAPSHOT_SAVE_DELAY
+
+
+class TestRegisterSnapshotStore:
+    """Test cases for RegisterSnapshotStore."""
+
+    @pytest.fixture
+    def store(self):
+        """Create a snapshot store backed by a mocked Home Assistant Store."""
+        with patch('custom_components.lxp_modbus.classes.register_snapshot.Store') as mock_store_cls:
+            mock_store = MagicMock()
+            mock_store.async_load = AsyncMock(return_value=None)
+            mock_store.async_save = AsyncMock()
+            mock_store.async_remove = AsyncMock()
+            mock_store_cls.return_value = mock_store
+            snapshot_store = RegisterSnapshotStore(MagicMock(), "entry123")
+        assert mock_store_cls.call_args[0][2] == "lxp_modbus.entry123.snapshot"
+        return snapshot_store, mock_store
+
+    @pytest.mark.asyncio
+    async def test_round_trip_restores_integer_keys(self, store):
+        """Test that register numbers come back as integers after JSON storage."""
+        snapshot_store, mock_store = store
+        data = {"input": {0: 12, 5: 480}, "hold": {7: 0x4142},
+                "battery": {"BAT0000001": {"serial": "BAT0000001", 8: 520, 10: 0x6450}}}
+        await snapshot_store.async_save(data)
+
+        saved = mock_store.async_save.call_args[0][0]
+        assert saved["input"] == {"0": 12, "5": 480}
+        assert "saved_at" in saved
+
+        mock_store.async_load.return_value = json.loads(json.dumps(saved))
+        assert await snapshot_store.async_load() == data
+
+    @pytest.mark.asyncio
+    async def test_load_missing_or_unusable(self, store):
+        """Test that empty, partial and corrupt snapshots are ignored."""
+        snapshot_store, mock_store = store
+        assert await snapshot_store.async_load() is None
+
+        mock_store.async_load.return_value = {"input": {"0": 1}, "hold": {}}
+        assert await snapshot_store.async_load() is None
+
+        mock_store.async_load.return_value = {"input": {"x": 1}, "hold": {"0": 1}}
+        assert await snapshot_store.async_load() is None
+
+    def test_schedule_save_is_throttled(self, store):
+        """Test that only one delayed write is pending and it serializes the latest data."""
+        snapshot_store, mock_store = store
+        snapshot_store.async_schedule_save({"input": {0: 1}, "hold": {0: 1}})
+        snapshot_store.async_schedule_save({"input": {0: 2}, "hold": {0: 2}})
+
+        mock_store.async_delay_save.assert_called_once()
+        data_func, delay = mock_store.async_delay_save.call_args[0]
+        assert delay == SNAPSHOT_SAVE_DELAY
+        assert data_func()["input"] == {"0": 2}
+
+        # Once written, the next poll schedules a new write
+        snapshot_store.async_schedule_save({"input": {0: 3}, "hold": {0: 3}})
+        assert mock_store.async_delay_save.call_count == 2
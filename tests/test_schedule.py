@@ -0,0 +1,52 @@
+"""Tests for the schedule register builder."""
+
+import pytest
+from datetime import time
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.schedule import SCHEDULE_FUNCTIONS, build_schedule_registers, compose_time
+from custom_components.lxp_modbus.utils import contiguous_runs
+
+
+class TestBuildScheduleRegisters:
+    """Test cases for build_schedule_registers."""
+
+    def test_windows_fill_slots_and_clear_the_rest(self):
+        """Test that given windows fill the slots in order and unused slots are cleared."""
+        values = build_schedule_registers({"ac_charge": [
+            {"start": time(0, 30), "end": time(4, 30)},
+            {"start": time(13, 0), "end": time(15, 0)},
+        ]})
+
+        assert values == {
+            68: compose_time(time(0, 30)), 69: compose_time(time(4, 30)),
+            70: compose_time(time(13, 0)), 71: compose_time(time(15, 0)),
+            72: 0, 73: 0,
+        }
+        assert compose_time(time(4, 30)) == 4 | (30 << 8)
+
+    def test_function_registers_form_one_frame(self):
+        """Test that every function's slots are one contiguous register range."""
+        for function, slots in SCHEDULE_FUNCTIONS.items():
+            registers = [register for slot in slots for register in slot]
+            assert len(contiguous_runs(registers, 40)) == 1, function
+
+    def test_other_functions_untouched(self):
+        """Test that only the given functions produce register values."""
+        values = build_schedule_registers({"generator": []})
+        assert sorted(values) == [256, 257, 258, 259]
+
+    def test_too_many_windows(self):
+        """Test that more windows than slots are rejected."""
+        window = {"start": time(1, 0), "end": time(2, 0)}
+        with pytest.raises(ValueError):
+            build_schedule_registers({"peak_shaving": [window] * 3})
+
+    def test_unknown_function(self):
+        """Test that an unknown function is rejected."""
+        with pytest.raises(ValueError):
+            build_schedule_registers({"charge_first": []})
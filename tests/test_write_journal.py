@@ -0,0 +1,76 @@
+"""Tests for the WriteJournal class."""
+
+import pytest
+
+# Import the module under test
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from custom_components.lxp_modbus.classes.write_journal import SOURCE_ACK, SOURCE_READ, WriteJournal
+
+
+class TestWriteJournal:
+    """Test cases for WriteJournal."""
+
+    @pytest.fixture
+    def journal(self):
+        return WriteJournal()
+
+    def test_add_merges_bits(self, journal):
+        """Test that successive changes of one register accumulate, the latest bit value winning."""
+        assert journal.add(21, 0b001, 0b001, 0b100) == 0b101
+        assert journal.add(21, 0b010, 0b010, 0b101) == 0b111
+        assert journal.add(21, 0b001, 0b000, 0b111) == 0b110
+
+        entry = journal.pending(21)
+        assert entry.previous == 0b100
+        assert entry.mask == 0b011
+        assert entry.bits == 0b010
+
+    def test_overlay_keeps_pending_bits(self, journal):
+        """Test that a stale read does not hide a pending change, but other bits still update."""
+        journal.add(21, 0b001, 0b001, 0b000)
+        regs = {21: 0b1000, 22: 5}
+        journal.overlay(regs)
+        assert regs == {21: 0b1001, 22: 5}
+
+    def test_confirm_requires_pending_bits(self, journal):
+        """Test that only a value carrying every pending bit confirms the entry."""
+        journal.add(64, 0xFFFF, 100, 50)
+
+        assert journal.confirm(64, 50, SOURCE_READ) is False
+        assert journal.pending(64) is not None
+        assert journal.confirm(64, 100, SOURCE_ACK) is True
+        assert journal.pending(64) is None
+        assert journal.confirm(64, 100, SOURCE_READ) is False
+
+        assert journal.get_stats() == {"pending": 0, "confirmed_by_ack": 1, "confirmed_by_read": 0, "reverted": 0}
+
+    def test_fail_returns_entry_once(self, journal):
+        """Test that a failed write hands out the entry for reverting exactly once."""
+        journal.add(64, 0xFFFF, 100, 50)
+
+        entry = journal.fail(64)
+        assert entry.previous == 50
+        assert entry.apply(entry.previous) == 100
+        assert journal.fail(64) is None
+        assert journal.get_stats()["reverted"] == 1
+
+    def test_fail_keeps_bits_of_later_writes(self, journal):
+        """Test that a failed write only reverts bits no later submission changed again."""
+        journal.add(64, 0xFFFF, 100, 50)
+        first = journal.last_sequence
+        journal.add(64, 0xFFFF, 120, 100)
+
+        assert journal.fail(64, first) is None
+        assert journal.pending(64).bits == 120
+
+        journal.add(21, 0b011, 0b011, 0b000)
+        first = journal.last_sequence
+        journal.add(21, 0b010, 0b000, 0b011)
+        failed = journal.fail(21, first)
+        assert (failed.mask, failed.bits) == (0b001, 0b001)
+        entry = journal.pending(21)
+        assert (entry.mask, entry.bits) == (0b010, 0b000)
+        assert journal.get_stats()["reverted"] == 1